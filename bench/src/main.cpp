@@ -0,0 +1,228 @@
+/*
+Copyright (c) <2016> <B.Hoessen>
+
+This file is part of saturnin.
+
+saturnin is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+saturnin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "saturnin/Array.h"
+#include "saturnin/CNFReader.h"
+#include "saturnin/Solver.h"
+#include "saturnin/StopWatch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cinttypes>
+#include <limits>
+#include <string>
+
+#ifndef SATURNIN_BENCH_INSTANCES
+#define SATURNIN_BENCH_INSTANCES "test/instances"
+#endif /* SATURNIN_BENCH_INSTANCES */
+
+namespace {
+
+    /** The instances used when no instance is given on the command line */
+    const char* const defaultInstances[] = {
+        "dp04s04.shuffled.cnf",
+        "dp04u03.shuffled.cnf",
+        "dp10s10.shuffled.cnf",
+        "manol-pipe-c9.cnf",
+        "openstacks-cnfdd.cnf",
+        "velev-engi-uns-1.0-4nd.cnf",
+        "schup-l2s-abp4-1-k31.cnf",
+        "all.used-as.sat04-986.simplified.cnf"
+    };
+
+    /** The options of the benchmark that are given to each solver */
+    struct BenchOptions {
+        /** The maximum number of restarts allowed for each instance */
+        unsigned int maxRestarts = std::numeric_limits<unsigned int>::max();
+        /** The threshold of the chronological backtracking, 0 to disable it */
+        unsigned int chronoThreshold = 0;
+        /** Whether the restarts keep the levels that would be rebuilt */
+        bool reuseTrail = true;
+        /** The heuristic used to pick the decisions */
+        saturnin::Solver::BranchingHeuristic branching = saturnin::Solver::BranchingHeuristic::VSIDS;
+        /** Whether the decisions use the target phases */
+        bool targetPhase = false;
+        /** Whether the phases are periodically reset */
+        bool rephase = false;
+        /** Whether the learnt clauses are vivified after each reduce */
+        bool vivify = true;
+        /** Whether the subsumed clauses are removed */
+        bool subsume = true;
+        /** Whether the failed literals are probed */
+        bool probe = true;
+        /** Whether the transitive binary clauses are removed */
+        bool transitive = true;
+        /** Whether the learnt clauses are minimized with the binary clauses */
+        bool binMinimize = true;
+        /** Whether the subsumed reasons are strengthened during the analysis */
+        bool otfs = true;
+    };
+
+    /** The values measured on all the instances */
+    struct BenchTotals {
+        double time = 0;
+        uint64_t propagations = 0;
+        uint64_t conflicts = 0;
+    };
+
+    void printHelp(const char* programName) {
+        printf("c Usage:\nc \t%s [OPTIONS] [INSTANCE.CNF...]\n", programName);
+        printf("c \tINSTANCE.CNF the instances to run. If none is given, the\n");
+        printf("c \t             instances of %s are used\n", SATURNIN_BENCH_INSTANCES);
+        printf("c \t-restarts=X  the maximum number of restarts for each instance\n");
+        printf("c \t-chrono=X    backtrack chronologically when the backjump\n");
+        printf("c \t             would remove more than X levels (0: never)\n");
+        printf("c \t-no-reuse-trail  backtrack to level 0 at each restart\n");
+        printf("c \t-vmtf        pick the decisions with VMTF instead of VSIDS\n");
+        printf("c \t-lrb         pick the decisions with LRB instead of VSIDS\n");
+        printf("c \t-target-phase  decide with the phases of the longest trail\n");
+        printf("c \t             without conflict\n");
+        printf("c \t-rephase     periodically reset the phases\n");
+        printf("c \t-no-vivify   don't shorten the learnt clauses after each reduce\n");
+        printf("c \t-no-subsume  don't remove the subsumed clauses\n");
+        printf("c \t-no-probe    don't probe the failed literals\n");
+        printf("c \t-no-transitive  don't remove the transitive binary clauses\n");
+        printf("c \t-no-bin-minimize  don't minimize the learnt clauses with the binary clauses\n");
+        printf("c \t-no-otfs     don't strengthen the reasons subsumed during the analysis\n");
+        printf("c \t-h           print this help text\n");
+    }
+
+    /**
+     * Solve a given instance and print the measured values
+     * @return false if the instance couldn't be read
+     */
+    bool runInstance(const char* fileName, const BenchOptions& opt, BenchTotals& totals) {
+        saturnin::CNFReader* reader = new saturnin::CNFReader(fileName);
+        saturnin::CNFReader::CNFReaderErrors error = reader->read();
+        if (error != saturnin::CNFReader::CNFReaderErrors::cnfError_noError) {
+            printf("c %s: %s\n", fileName, saturnin::CNFReader::getErrorString(error));
+            delete(reader);
+            return false;
+        }
+        saturnin::StopWatch w;
+        w.start();
+        saturnin::Solver s(reader->getNbVar(), reader->getNbClauses());
+        s.setVerbosity(0);
+        s.setChronologicalBacktrack(opt.chronoThreshold);
+        s.setReuseTrail(opt.reuseTrail);
+        s.setBranchingHeuristic(opt.branching);
+        s.setTargetPhase(opt.targetPhase);
+        s.setRephase(opt.rephase);
+        s.setVivification(opt.vivify);
+        s.setSubsumption(opt.subsume);
+        s.setProbing(opt.probe);
+        s.setTransitiveReduction(opt.transitive);
+        s.setBinaryMinimization(opt.binMinimize);
+        s.setOnTheFlySubsumption(opt.otfs);
+        for (unsigned int i = 0; i < reader->getNbClauses(); i++) {
+            s.addClause(reader->getClause(i));
+        }
+        delete(reader);
+        reader = nullptr;
+
+        s.solve(opt.maxRestarts);
+        w.stop();
+
+        double time = w.getTimeEllapsed();
+        //avoid dividing by 0 on the trivial instances
+        double div = time > 0 ? time : 0.001;
+        const char* name = strrchr(fileName, '/');
+        name = name == nullptr ? fileName : name + 1;
+        const char* answer = s.getState() == wTrue ? "SAT" :
+                (s.getState() == wFalse ? "UNSAT" : "UNKNOWN");
+        printf("%-40.40s %-7s %9.2f %14" PRIu64 " %14.0f %10" PRIu64 " %10.0f\n",
+                name, answer, time, s.getNbPropagation(), s.getNbPropagation() / div,
+                s.getNbConflict(), s.getNbConflict() / div);
+        fflush(stdout);
+
+        totals.time += time;
+        totals.propagations += s.getNbPropagation();
+        totals.conflicts += s.getNbConflict();
+        return true;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    saturnin::Array<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-h", (size_t) 2) == 0) {
+            printHelp(argv[0]);
+            return EXIT_SUCCESS;
+        } else if (strncmp(argv[i], "-restarts=", (size_t) 10) == 0) {
+            char* out = nullptr;
+            unsigned long val = strtoul(argv[i] + 10, &out, 10);
+            if (out != argv[i] + 10) {
+                opt.maxRestarts = static_cast<unsigned int>(val);
+            }
+        } else if (strncmp(argv[i], "-vmtf", (size_t) 5) == 0) {
+            opt.branching = saturnin::Solver::BranchingHeuristic::VMTF;
+        } else if (strncmp(argv[i], "-lrb", (size_t) 4) == 0) {
+            opt.branching = saturnin::Solver::BranchingHeuristic::LRB;
+        } else if (strncmp(argv[i], "-target-phase", (size_t) 13) == 0) {
+            opt.targetPhase = true;
+        } else if (strncmp(argv[i], "-rephase", (size_t) 8) == 0) {
+            opt.rephase = true;
+        } else if (strncmp(argv[i], "-no-vivify", (size_t) 10) == 0) {
+            opt.vivify = false;
+        } else if (strncmp(argv[i], "-no-subsume", (size_t) 11) == 0) {
+            opt.subsume = false;
+        } else if (strncmp(argv[i], "-no-probe", (size_t) 9) == 0) {
+            opt.probe = false;
+        } else if (strncmp(argv[i], "-no-transitive", (size_t) 14) == 0) {
+            opt.transitive = false;
+        } else if (strncmp(argv[i], "-no-bin-minimize", (size_t) 16) == 0) {
+            opt.binMinimize = false;
+        } else if (strncmp(argv[i], "-no-otfs", (size_t) 8) == 0) {
+            opt.otfs = false;
+        } else if (strncmp(argv[i], "-no-reuse-trail", (size_t) 15) == 0) {
+            opt.reuseTrail = false;
+        } else if (strncmp(argv[i], "-chrono=", (size_t) 8) == 0) {
+            char* out = nullptr;
+            unsigned long val = strtoul(argv[i] + 8, &out, 10);
+            if (out != argv[i] + 8) {
+                opt.chronoThreshold = static_cast<unsigned int>(val);
+            }
+        } else {
+            files.push(argv[i]);
+        }
+    }
+
+    printf("%-40s %-7s %9s %14s %14s %10s %10s\n", "instance", "answer",
+            "time (s)", "propagations", "propag/s", "conflicts", "confl/s");
+    BenchTotals totals;
+    bool success = true;
+    if (files.getSize() == 0) {
+        for (const char* instance : defaultInstances) {
+            std::string path = std::string(SATURNIN_BENCH_INSTANCES) + "/" + instance;
+            success = runInstance(path.c_str(), opt, totals) && success;
+        }
+    } else {
+        for (unsigned int i = 0; i < files.getSize(); i++) {
+            success = runInstance(files[i], opt, totals) && success;
+        }
+    }
+    double div = totals.time > 0 ? totals.time : 0.001;
+    printf("%-40s %-7s %9.2f %14" PRIu64 " %14.0f %10" PRIu64 " %10.0f\n",
+            "total", "", totals.time, totals.propagations, totals.propagations / div,
+            totals.conflicts, totals.conflicts / div);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
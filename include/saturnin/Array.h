@@ -291,6 +291,28 @@ namespace saturnin {
             size++;
         }
 
+        /**
+         * Make sure this Array can contain at least @a c elements without
+         * having to resize itself
+         * @param c the number of elements needed
+         */
+        void reserve(unsigned int c) {
+            if (c <= cap) {
+                return;
+            }
+            T* tmp = (T*) new char[c * sizeof (T)];
+            ASSERT(tmp != nullptr);
+#ifdef DEBUG
+            memset(tmp, 0, c * sizeof (T));
+#endif /* DEBUG */
+            if (data != nullptr) {
+                memcpy(tmp, data, size * sizeof (T));
+                delete[](reinterpret_cast<char*>(data));
+            }
+            data = tmp;
+            cap = c;
+        }
+
         /**
          * Remove the last element of this array
          * @return a copy of the element that was removed
@@ -110,6 +110,14 @@ namespace saturnin {
          */
         const Array<Lit>& getClause(unsigned int i) const;
 
+        /**
+         * Retrieve every clause read
+         * @return the clauses, in the order of the file
+         */
+        const Array<Array<Lit> >& getClauses() const {
+            return clauses;
+        }
+
         /**
          * Retrieve the list of presumed true literals
          * @return an array containing the literals that are presumed true
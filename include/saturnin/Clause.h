@@ -28,11 +28,21 @@ along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
 #include "Saturnin.h"
 
 #include <stdint.h>
+#include <limits>
 
 #define SATURNIN_MAX_LBD_VALUE ((1<<16)-1)
 
 namespace saturnin {
 
+    /**
+     * A reference to a clause stored in a ClauseArena. It is the offset of
+     * the clause, in 32 bits words, from the beginning of the arena
+     */
+    typedef uint32_t CRef;
+
+    /** The value representing an undefined clause reference */
+    static const CRef CRef_Undef = std::numeric_limits<CRef>::max();
+
     /**
      * This class represent a clause. In order to be memory efficient, the
      * array containing the literals (data) is defined as a 0-length array at
@@ -167,6 +177,7 @@ namespace saturnin {
         inline void removeLit(unsigned int pos){
             data[pos] = data[size-1];
             size--;
+            data[size] = lit_Undef;
         }
 
 
@@ -271,6 +282,66 @@ namespace saturnin {
             compact.freezeCounter = 0;
         }
 
+        /**
+         * Check if this clause has been removed from the solver. Such a
+         * clause is only kept until its watchers are dropped
+         * @return true if the clause has to be removed from the watches
+         */
+        inline bool isToRemove() const{
+            return compact.toRemove != 0;
+        }
+
+        /**
+         * Mark this clause as removed from the solver
+         * @param rm true if the clause has to be removed from the watches
+         */
+        inline void setToRemove(bool rm){
+            compact.toRemove = rm;
+        }
+
+        /**
+         * Check if this clause has already been vivified
+         * @return true if the vivification already tried to shorten it
+         */
+        inline bool isVivified() const{
+            return compact.vivified != 0;
+        }
+
+        /**
+         * Mark this clause as vivified
+         * @param viv true if the vivification shouldn't try it again
+         */
+        inline void setVivified(bool viv){
+            compact.vivified = viv;
+        }
+
+        /**
+         * Check if this clause has been moved to another ClauseArena
+         * @return true if the clause has been relocated
+         */
+        inline bool isRelocated() const{
+            return compact.relocated != 0;
+        }
+
+        /**
+         * Mark this clause as moved to another ClauseArena. The literals of
+         * this clause aren't valid anymore after this call
+         * @param to the reference of the clause in the new arena
+         */
+        inline void relocate(CRef to){
+            compact.relocated = 1;
+            data[0] = to;
+        }
+
+        /**
+         * Retrieve the reference of the clause in the arena it was moved to
+         * @return the reference of the relocated clause
+         */
+        inline CRef getRelocation() const{
+            ASSERT(isRelocated());
+            return data[0];
+        }
+
         /**
          * Check if two clauses are equals.
          * Two clauses are equals if they have the same size and if
@@ -296,7 +367,11 @@ namespace saturnin {
             /** The literal block distance of the clause */
             unsigned lbd : 16;
             /** Allows to known if this clause have to be removed from the watches*/
-            unsigned toRemove : 4;
+            unsigned toRemove : 2;
+            /** Allows to known if this clause has already been vivified */
+            unsigned vivified : 1;
+            /** Allows to known if this clause has been moved to another arena */
+            unsigned relocated : 1;
             /** Allows to known if this clause is currently attached to the solver*/
             unsigned attached : 4;
             /** Represent the number of times a clause was frozen */
@@ -306,9 +381,11 @@ namespace saturnin {
     private:
 
         friend class PoolList;
+        friend class ClauseArena;
 
         /**
-         * Creates a new Clause. Should only be called from PoolList
+         * Creates a new Clause. Should only be called from PoolList or
+         * ClauseArena
          * @param literals the array containing the literals
          * @param sz the number of literals in this clause, and in @a literals
          * @param lbd the literal block distance of the clause
@@ -335,51 +412,136 @@ namespace saturnin {
     };
 
 
-    /** The structure used in lazy occurrence lists */
+    /**
+     * The structure used in lazy occurrence lists.
+     * A single watch list per literal holds every kind of clause: binary
+     * clauses keep the other literal inline (no clause is attached to them),
+     * initial ternary clauses keep both other literals inline and are watched
+     * by each of their literals, clauses of size 3+ keep a blocking literal
+     * next to the clause and frozen clauses are watched by only one literal.
+     * The kind of the watcher is stored in the two highest bits of the clause
+     * reference so that a watcher only uses 8 bytes.
+     */
     struct watcher_t {
+
+        /** The different kinds of watchers */
+        enum watch_kind : uint32_t {
+            /** A clause of size 3+ using the 2 literal watched scheme */
+            wkLong = 0,
+            /** A binary clause, block is the other literal of the clause */
+            wkBinary = 1,
+            /** A frozen clause of size 3+, watched by only one literal */
+            wkFrozen = 2,
+            /**
+             * An initial clause of size 3, block and the reference part hold
+             * the two other literals of the clause
+             */
+            wkTernary = 3
+        };
+
+        /** The number of bits used to store the clause reference */
+        static const uint32_t refBits = 30;
+        /** The mask used to retrieve the clause reference */
+        static const uint32_t refMask = (1U << refBits) - 1;
+
         /**
          * Constructor
-         * @param w the clause to watch
-         * @param l the blocking literal
+         * @param c the reference of the clause to watch, or the second other
+         *          literal for a ternary clause
+         * @param l the blocking literal, or the first other literal for a
+         *          ternary clause
+         * @param k the kind of watcher (either wkLong, wkFrozen or wkTernary)
          */
-        watcher_t(Clause* w, Lit l) : watched(w), block(l) {
-            ASSERT(watched != nullptr);
-            ASSERT(watched->contains(block));
+        watcher_t(CRef c, Lit l, watch_kind k = wkLong) : data((static_cast<uint32_t>(k) << refBits) | c), block(l) {
+            ASSERT(k != wkBinary);
+            ASSERT(c <= refMask);
         }
 
         /**
-         * Move constructor
-         * @param other the source of the copy
+         * Constructor for a binary clause
+         * @param other the other literal of the binary clause
          */
-        watcher_t(watcher_t&& other) : watched(other.watched), block(other.block) {
-            ASSERT(watched != nullptr);
-            ASSERT(watched->contains(block));
+        explicit watcher_t(Lit other) : data(static_cast<uint32_t>(wkBinary) << refBits), block(other) {
         }
 
         /**
-         * Copy constructor
-         * @param other the source of the copy
+         * Retrieve the reference of the clause being watched. It has no
+         * meaning for binary and ternary clauses
+         * @return the reference of the watched clause
          */
-        watcher_t(const watcher_t & other) : watched(other.watched), block(other.block) {
-            ASSERT(watched != nullptr);
-            ASSERT(watched->contains(block));
+        inline CRef getRef() const {
+            return data & refMask;
         }
 
         /**
-         * Copy assignment operator
-         * @param other the source of the copy
-         * @return the destination of the copy
+         * Retrieve the second other literal of a ternary clause, the first
+         * one being block
+         * @return the literal stored in place of the clause reference
          */
-        watcher_t& operator=(const watcher_t & other) {
-            watched = other.watched;
-            block = other.block;
-            ASSERT(watched != nullptr);
-            ASSERT(watched->contains(block));
-            return *this;
+        inline Lit getOther() const {
+            return data & refMask;
         }
-        /** The clause being watched */
-        Clause* watched;
-        /** The blocking literal */
+
+        /**
+         * Change the reference of the clause being watched, keeping the kind
+         * of this watcher
+         * @param c the new reference of the watched clause
+         */
+        inline void setRef(CRef c) {
+            ASSERT(c <= refMask);
+            data = (data & ~refMask) | c;
+        }
+
+        /**
+         * Retrieve the kind of this watcher
+         * @return the kind of this watcher
+         */
+        inline watch_kind getKind() const {
+            return static_cast<watch_kind>(data >> refBits);
+        }
+
+        /**
+         * Check if this watcher represents a binary clause
+         * @return true if the watcher represents a binary clause
+         */
+        inline bool isBinary() const {
+            return getKind() == wkBinary;
+        }
+
+        /**
+         * Check if this watcher represents a frozen clause
+         * @return true if the watcher represents a clause watched by only one
+         *         literal
+         */
+        inline bool isFrozen() const {
+            return getKind() == wkFrozen;
+        }
+
+        /**
+         * Check if this watcher represents a ternary clause
+         * @return true if both other literals of the clause are inline
+         */
+        inline bool isTernary() const {
+            return getKind() == wkTernary;
+        }
+
+        /**
+         * Check if this watcher doesn't refer to a clause of the arena
+         * @return true if the watcher represents a binary or ternary clause
+         */
+        inline bool isImplicit() const {
+            return getKind() == wkBinary || getKind() == wkTernary;
+        }
+
+        /**
+         * The kind of the watcher followed by the watched clause reference,
+         * or the second other literal for ternary clauses
+         */
+        uint32_t data;
+        /**
+         * The blocking literal, or the (first) other literal for binary and
+         * ternary clauses
+         */
         Lit block;
     };
     
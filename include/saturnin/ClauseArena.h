@@ -0,0 +1,239 @@
+/*
+Copyright (c) <2012> <B.Hoessen>
+
+This file is part of saturnin.
+
+saturnin is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+saturnin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SATURNIN_CLAUSEARENA_H
+#define	SATURNIN_CLAUSEARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Array.h"
+#include "Assert.h"
+#include "Clause.h"
+#include "VariablesManager.h"
+#include "Saturnin.h"
+
+namespace saturnin {
+
+#ifndef SATURNIN_CLAUSEARENA_UPDATE_FACTOR
+#define SATURNIN_CLAUSEARENA_UPDATE_FACTOR 1.5
+#endif
+
+    /**
+     * This class represent a ClauseArena: a single growable chunk of memory
+     * in which the clauses are stored one after the other. A clause is
+     * identified by its offset in the arena (a CRef) instead of its address.
+     * Since the arena may be moved in memory whenever it grows, a pointer to
+     * a clause is only valid until the next call to createClause.
+     * Released clauses aren't reused: their memory is only accounted as
+     * wasted until the live clauses are relocated into a new arena.
+     */
+    class SATURNIN_EXPORT ClauseArena final {
+    public:
+
+        /**
+         * Create a new ClauseArena
+         * @param capacity the initial capacity of the arena, in 32 bits words
+         */
+        ClauseArena(unsigned int capacity);
+
+        /**
+         * Destructor.
+         * Every clause that was generated with this arena won't be usable
+         * anymore
+         */
+        ~ClauseArena();
+
+        /**
+         * Create a new clause
+         * @param lits the array containing the literals
+         * @param sz the number of literals in the array @a lits
+         * @param lbd the literal block distance of the clause
+         * @return the reference of the clause of size @a sz containing the
+         *         literals in @a lits and having the literal block distance
+         *         set to @a lbd
+         */
+        CRef createClause(const Lit* const lits, unsigned int sz, unsigned int lbd = 0);
+
+        /**
+         * Create a new clause
+         * @param lits the array containing the literals
+         * @param lbd the literal block distance of the clause
+         * @return the reference of the clause containing the literals in
+         *         @a lits and having the literal block distance set to @a lbd
+         */
+        CRef createClause(const Array<Lit>& lits, unsigned int lbd = 0);
+
+        /**
+         * Release a clause that was generated by this arena
+         * @param c the reference of the clause to release. It will be set to
+         *          CRef_Undef after
+         */
+        void releaseClause(CRef& c);
+
+        /**
+         * Remove a literal from a clause generated by this arena. The last
+         * literal of the clause takes its place and the word it used is
+         * wasted until the next relocation
+         * @param c the reference of the clause
+         * @param pos the position of the literal to remove
+         */
+        void removeLit(CRef c, unsigned int pos);
+
+        /**
+         * Copy a clause of this arena into another arena. The first time a
+         * clause is relocated, it is copied at the end of @a to and marked as
+         * relocated. The next calls only retrieve its new reference.
+         * @param c the reference of the clause to relocate. It will be set to
+         *          the reference of the clause in @a to
+         * @param to the arena that will hold the clause
+         */
+        void relocate(CRef& c, ClauseArena& to);
+
+        /**
+         * Give the memory of this arena to another arena. The previous memory
+         * of @a to is released and this arena becomes empty
+         * @param to the arena that will hold the clauses of this arena
+         */
+        void moveTo(ClauseArena& to);
+
+        /**
+         * Retrieve a clause from its reference
+         * @param c the reference of the clause
+         * @return the clause referenced by @a c
+         */
+        inline Clause& operator[](CRef c) {
+            ASSERT(c < size);
+            return *reinterpret_cast<Clause*>(memory + c);
+        }
+
+        /**
+         * Retrieve a clause from its reference
+         * @param c the reference of the clause
+         * @return the clause referenced by @a c
+         */
+        inline const Clause& operator[](CRef c) const {
+            ASSERT(c < size);
+            return *reinterpret_cast<const Clause*>(memory + c);
+        }
+
+        /**
+         * Retrieve the reference of a clause stored in this arena
+         * @param c the clause
+         * @return the reference of @a c
+         */
+        inline CRef getRef(const Clause& c) const {
+            ASSERT(reinterpret_cast<const uint32_t*>(&c) >= memory);
+            ASSERT(reinterpret_cast<const uint32_t*>(&c) < memory + size);
+            return static_cast<CRef>(reinterpret_cast<const uint32_t*>(&c) - memory);
+        }
+
+        /**
+         * Retrieve the number of words used by a clause of a given size
+         * @param sz the number of literals of the clause
+         * @return the number of 32 bits words needed to hold the clause
+         */
+        static inline unsigned int getNbWords(unsigned int sz) {
+            return static_cast<unsigned int>((sizeof (Clause) + sz * sizeof (Lit)) / sizeof (uint32_t));
+        }
+
+        /**
+         * Retrieve the number of words used in the arena, including the
+         * words of released clauses
+         * @return the number of 32 bits words used
+         */
+        inline unsigned int getSize() const {
+            return size;
+        }
+
+        /**
+         * Retrieve the capacity of the arena
+         * @return the number of 32 bits words that can be used before the
+         *         arena needs to grow
+         */
+        inline unsigned int getCapacity() const {
+            return capacity;
+        }
+
+        /**
+         * Retrieve the number of words belonging to released clauses
+         * @return the number of 32 bits words that are not used anymore
+         */
+        inline unsigned int getWasted() const {
+            return wasted;
+        }
+
+        /**
+         * Retrieve the number of clauses currently alive in the arena
+         * @return the number of clauses created and not released yet
+         */
+        inline unsigned int getNbClauses() const {
+            return nbClauses;
+        }
+
+        /**
+         * Retrieve the memory footprint of this arena
+         * @return the memory allocated in bytes for this arena
+         */
+        inline size_t getMemoryFootprint() const {
+            size_t mem = capacity * sizeof (uint32_t);
+#ifdef PROFILE
+            mem += clauseRepartition.getMemoryFootprint();
+#endif /* PROFILE */
+            return mem;
+        }
+
+#ifdef PROFILE
+        /** Retrieve the array containing the number of clause made by this arena for a given size*/
+        const Array<unsigned int>& getClauseRepartition() const { return clauseRepartition; }
+#endif /* PROFILE */
+
+    private:
+
+        /**
+         * Reserve some words at the end of the arena, growing it if needed
+         * @param nbWords the number of words needed
+         * @return the reference of the first reserved word
+         */
+        CRef allocate(unsigned int nbWords);
+
+        /** The memory holding the clauses */
+        uint32_t* memory;
+        /** The number of words used in memory */
+        unsigned int size;
+        /** The number of words allocated in memory */
+        unsigned int capacity;
+        /** The number of words used by released clauses */
+        unsigned int wasted;
+        /** The number of clauses alive in the arena */
+        unsigned int nbClauses;
+
+#ifdef PROFILE
+        Array<unsigned int> clauseRepartition;
+#endif /* PROFILE */
+
+        //! @cond Doxygen_Suppress
+        ClauseArena(const ClauseArena&) = delete;
+        ClauseArena& operator=(const ClauseArena&) = delete;
+        //! @endcond
+
+    };
+
+}
+
+#endif	/* SATURNIN_CLAUSEARENA_H */
@@ -51,6 +51,23 @@ namespace saturnin {
             }
         }
 
+        /**
+         * Compare two values, as they are stored inline in the heap
+         * @param a the first value to compare
+         * @param b the second value to compare
+         * @return a negative number if @a a lower than @a b, a positive number
+         *         if @a is greater than @b or zero if @a equals @b
+         */
+        inline int compareKeys(const V& a, const V& b) const {
+            if (a < b) {
+                return -1;
+            } else if (a > b) {
+                return 1;
+            } else {
+                return 0;
+            }
+        }
+
         /**
          * Retrieve the value associated with a given key
          * @param key the key we want its value
@@ -61,7 +78,68 @@ namespace saturnin {
         }
 
     };
-    
+
+    /**
+     * An element of the array of a Heap. Only the variable is stored, its
+     * value is asked to the comparator on each comparison
+     */
+    template<typename T, bool InlineKeys>
+    struct HeapEntry {
+        /** The variable */
+        Var var;
+
+        /**
+         * Retrieve the value of the variable from the comparator
+         * @param c the comparator of the heap
+         */
+        template<class Comp>
+        inline void readKey(const Comp& c) {
+            (void) c;
+        }
+
+        /**
+         * Check if this entry must be above another one in the heap
+         * @param other the other entry
+         * @param c the comparator of the heap
+         * @return true if this entry is strictly lower than @a other
+         */
+        template<class Comp>
+        inline bool lower(const HeapEntry& other, const Comp& c) const {
+            return c.compare(var, other.var) < 0;
+        }
+    };
+
+    /**
+     * An element of the array of a Heap that keeps a copy of the value of
+     * its variable, so that a comparison doesn't read the comparator
+     */
+    template<typename T>
+    struct HeapEntry<T, true> {
+        /** The variable */
+        Var var;
+        /** The value of the variable when it was last read */
+        T key;
+
+        /**
+         * Retrieve the value of the variable from the comparator
+         * @param c the comparator of the heap
+         */
+        template<class Comp>
+        inline void readKey(const Comp& c) {
+            key = c[var];
+        }
+
+        /**
+         * Check if this entry must be above another one in the heap
+         * @param other the other entry
+         * @param c the comparator of the heap
+         * @return true if this entry is strictly lower than @a other
+         */
+        template<class Comp>
+        inline bool lower(const HeapEntry& other, const Comp& c) const {
+            return c.compareKeys(key, other.key) < 0;
+        }
+    };
 
     /**
      * This class represent a Heap. A data structure that allows to add
@@ -69,9 +147,19 @@ namespace saturnin {
      * key present in this heap.
      * In order to work, if n integer must be present in the heap must range
      * from 0 to n-1 and be inserted in order
+     * Each node of the heap has @a Arity sons. If @a InlineKeys is true, the
+     * value of each variable is copied next to it in the heap, and the
+     * comparator must provide compareKeys. In that case, updateValue (or
+     * rebuild) must be called whenever the value of a variable present in the
+     * heap changes.
      */
-    template<typename T, class Comp = HeapHelper<Var, T> >
+    template<typename T, class Comp = HeapHelper<Var, T>, unsigned int Arity = 2, bool InlineKeys = false>
     class Heap final {
+        static_assert(Arity >= 2, "A heap needs at least 2 sons per node");
+
+        /** The type of the elements of the heap array */
+        typedef HeapEntry<T, InlineKeys> Entry;
+
     public:
 
         /**
@@ -109,7 +197,7 @@ namespace saturnin {
          * @return true if @a v is present in the heap, false otherwise
          */
         bool contains(const Var v) const {
-            return positions[v] < data.getSize() && data.get(positions[v]) == v;
+            return v < positions.getSize() && positions[v] < data.getSize() && data.get(positions[v]).var == v;
         }
 
         /**
@@ -117,16 +205,40 @@ namespace saturnin {
          * @param v the variable to add to the heap
          */
         void add(const Var v) {
-            if (v >= positions.getSize()) {
-                while (v >= positions.getSize()) {
-                    positions.push((unsigned int) - 1);
+            append(v);
+            percolateUp(v);
+            ASSERT_EQUAL(v, data.get(positions[v]).var);
+        }
+
+        /**
+         * Add several variables to the heap. When they are numerous compared
+         * to the variables already present, the heap is rebuilt in linear
+         * time instead of percolating each of them
+         * @param vars the variables to add, none of them may be present
+         */
+        void addAll(const Array<Var>& vars) {
+            if (vars.getSize() * Arity < data.getSize()) {
+                for (unsigned int i = 0; i < vars.getSize(); i++) {
+                    add(vars.get(i));
                 }
+                return;
             }
-            ASSERT(!contains(v));
-            data.push(v);
-            positions[v] = data.getSize() - 1;
-            percolateUp(v);
-            ASSERT_EQUAL(v, data.get(positions[v]));
+            for (unsigned int i = 0; i < vars.getSize(); i++) {
+                append(vars.get(i));
+            }
+            heapify();
+        }
+
+        /**
+         * Read again the value of every variable present in the heap and
+         * restore the heap property in linear time. It is needed when the
+         * values of many variables changed without calling updateValue
+         */
+        void rebuild() {
+            for (unsigned int i = 0; i < data.getSize(); i++) {
+                data[i].readKey(comparator);
+            }
+            heapify();
         }
 
         /**
@@ -135,8 +247,8 @@ namespace saturnin {
          */
         Var getMin() const {
             ASSERT(data.getSize()>(unsigned int) 0);
-            ASSERT_EQUAL((unsigned int) 0, positions[data.get(0)]);
-            return data.get((unsigned int) 0);
+            ASSERT_EQUAL((unsigned int) 0, positions[data.get(0).var]);
+            return data.get((unsigned int) 0).var;
         }
 
         /**
@@ -145,11 +257,11 @@ namespace saturnin {
          */
         Var removeMin() {
             ASSERT(data.getSize()>(unsigned int) 0);
-            Var v = data.get((unsigned int) 0);
+            Var v = data.get((unsigned int) 0).var;
             ASSERT_EQUAL((unsigned int) 0, positions[v]);
             unsigned int size = data.getSize();
             if (size > 1) {
-                Var other = data.get(size - 1);
+                Var other = data.get(size - 1).var;
                 ASSERT_EQUAL(size - 1, positions[other]);
                 swap(positions[v], positions[other]);
                 swap(data[0U], data[size - 1]);
@@ -168,7 +280,7 @@ namespace saturnin {
          * @return the value related to the variable
          */
         T operator[](Var v) const {
-            ASSERT_EQUAL(v, data.get(positions.get(v)));
+            ASSERT_EQUAL(v, data.get(positions.get(v)).var);
             return comparator[v];
         }
 
@@ -179,10 +291,11 @@ namespace saturnin {
         void updateValue(Var v) {
             unsigned int pos = positions[v];
             ASSERT(pos < data.getSize());
-            ASSERT_EQUAL(v, data[pos]);
-            if (pos != 0 && comparator.compare(v, data.get(parent(pos))) < 0) {
+            ASSERT_EQUAL(v, data[pos].var);
+            data[pos].readKey(comparator);
+            if (pos != 0 && data.get(pos).lower(data.get(parent(pos)), comparator)) {
                 percolateUp(v);
-            } else if (pos == 0 || comparator.compare(v, data.get(parent(pos))) > 0) {
+            } else if (pos == 0 || data.get(parent(pos)).lower(data.get(pos), comparator)) {
                 percolateDown(v);
             }
         }
@@ -204,14 +317,10 @@ namespace saturnin {
          */
         bool check(unsigned int pos = 0)const {
             ASSERT(pos < data.getSize());
-            ASSERT_EQUAL(pos, positions.get(data.get(pos)));
-            if (left(pos) < data.getSize()) {
-                ASSERT(comparator.compare(data.get(pos), data.get(left(pos))) <= 0);
-                ASSERT(check(left(pos)));
-            }
-            if (right(pos) < data.getSize()) {
-                ASSERT(comparator.compare(data.get(pos), data.get(right(pos))) <= 0);
-                ASSERT(check(right(pos)));
+            ASSERT_EQUAL(pos, positions.get(data.get(pos).var));
+            for (unsigned int son = firstSon(pos); son < data.getSize() && son <= lastSon(pos); son++) {
+                ASSERT(!data.get(son).lower(data.get(pos), comparator));
+                ASSERT(check(son));
             }
             return true;
         }
@@ -227,6 +336,38 @@ namespace saturnin {
 
     private:
 
+        /**
+         * Put a variable at the end of the heap array, without restoring the
+         * heap property
+         * @param v the variable to add
+         */
+        void append(const Var v) {
+            if (v >= positions.getSize()) {
+                while (v >= positions.getSize()) {
+                    positions.push((unsigned int) - 1);
+                }
+            }
+            ASSERT(!contains(v));
+            Entry e;
+            e.var = v;
+            e.readKey(comparator);
+            data.push(e);
+            positions[v] = data.getSize() - 1;
+        }
+
+        /**
+         * Restore the heap property of the whole array, in linear time
+         */
+        void heapify() {
+            unsigned int size = data.getSize();
+            if (size < 2) {
+                return;
+            }
+            for (unsigned int pos = parent(size - 1) + 1; pos > 0; pos--) {
+                percolateDown(data[pos - 1].var);
+            }
+        }
+
         /**
          * Percolate the position of a variable as the new value of the variable
          * is lower than its previous value
@@ -235,21 +376,22 @@ namespace saturnin {
         void percolateUp(Var v) {
             unsigned int pos = positions[v];
             ASSERT(pos < data.getSize());
-            ASSERT_EQUAL(v, data[pos]);
+            ASSERT_EQUAL(v, data[pos].var);
+            Entry e = data[pos];
             bool stop = false;
             while (!stop && pos > 0) {
                 unsigned int par = parent(pos);
-                if (comparator.compare(data[pos], data[par]) < 0) {
-                    swap(data[par], data[pos]);
+                if (e.lower(data[par], comparator)) {
+                    data[pos] = data[par];
                     //update the position of the parent (which is now at pos)
-                    positions[data[pos]] = pos;
+                    positions[data[pos].var] = pos;
                     pos = par;
                 } else {
                     stop = true;
                 }
             }
             positions[v] = pos;
-            data[pos] = v;
+            data[pos] = e;
         }
 
         /**
@@ -260,23 +402,29 @@ namespace saturnin {
         void percolateDown(Var v) {
             unsigned int pos = positions[v];
             ASSERT(pos < data.getSize());
-            ASSERT_EQUAL(v, data[pos]);
+            ASSERT_EQUAL(v, data[pos].var);
+            Entry e = data[pos];
             unsigned int size = data.getSize();
             bool stop = false;
-            while (!stop && left(pos) < size) {
-                unsigned int son = right(pos) < size &&
-                        comparator.compare(data[right(pos)],
-                            data[left(pos)]) < 0 ? right(pos) : left(pos);
-                if (comparator.compare(data[pos], data[son]) > 0) {
-                    swap(data[pos], data[son]);
+            while (!stop && firstSon(pos) < size) {
+                //look for the lowest son
+                unsigned int son = firstSon(pos);
+                unsigned int last = lastSon(pos) < size ? lastSon(pos) : size - 1;
+                for (unsigned int other = son + 1; other <= last; other++) {
+                    if (data[other].lower(data[son], comparator)) {
+                        son = other;
+                    }
+                }
+                if (data[son].lower(e, comparator)) {
+                    data[pos] = data[son];
                     //update the position of the son (which is now at pos)
-                    positions[data[pos]] = pos;
+                    positions[data[pos].var] = pos;
                     pos = son;
                 } else {
                     stop = true;
                 }
             }
-            data[pos] = v;
+            data[pos] = e;
             positions[v] = pos;
         }
 
@@ -293,23 +441,23 @@ namespace saturnin {
         }
 
         /**
-         * Retrieve the position of the left son of an element at a given
+         * Retrieve the position of the first son of an element at a given
          * position
-         * @param pos the position of the element we want its left son
-         * @return the position of the left son of the element at position @a pos
+         * @param pos the position of the element we want its first son
+         * @return the position of the first son of the element at position @a pos
          */
-        inline unsigned int left(unsigned int pos) const {
-            return (pos << 1) + 1;
+        inline unsigned int firstSon(unsigned int pos) const {
+            return pos * Arity + 1;
         }
 
         /**
-         * Retrieve the position of the right son of an element at a given
+         * Retrieve the position of the last son of an element at a given
          * position
-         * @param pos the position of the element we want its right son
-         * @return the position of the right son of the element at position @a pos
+         * @param pos the position of the element we want its last son
+         * @return the position of the last son of the element at position @a pos
          */
-        inline unsigned int right(unsigned int pos) const {
-            return (pos << 1) + 2;
+        inline unsigned int lastSon(unsigned int pos) const {
+            return pos * Arity + Arity;
         }
 
         /**
@@ -318,12 +466,12 @@ namespace saturnin {
          * @return the position of the parent of the element at position @a pos
          */
         inline unsigned int parent(unsigned int pos) const {
-            return (pos - 1) >> 1;
+            return (pos - 1) / Arity;
         }
 
 
         /** The structure containing the key and the value */
-        Array<Var> data;
+        Array<Entry> data;
 
         /**
          * The map containing the position of the different integer in the data
@@ -339,4 +487,3 @@ namespace saturnin {
 }
 
 #endif	/* SATURNIN_HEAP_H */
-
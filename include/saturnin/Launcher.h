@@ -99,8 +99,17 @@ namespace saturnin {
          */
         void printMemoryValue(FILE* f, size_t mem) const;
 
-        /** Perform a simplification of the instance given by the reader and add the simplified instance in the given solver */
-        void simplify(Solver& s, CNFReader& reader);
+        /**
+         * Perform a simplification of the instance given by the reader and add
+         * the simplified instance in the given solver
+         * @param covered true to remove the covered clauses as well as the
+         *        blocked ones
+         * @param nbSubstituted set to the number of variables replaced by an
+         *        equivalent literal
+         * @param nbBlocked set to the number of blocked clauses removed
+         * @return the number of variables eliminated
+         */
+        unsigned int simplify(Solver& s, CNFReader& reader, bool covered, unsigned int& nbSubstituted, unsigned int& nbBlocked);
 
         void printStats(Solver& s) const;
 
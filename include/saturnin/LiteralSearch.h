@@ -0,0 +1,119 @@
+/*
+Copyright (c) <2012> <B.Hoessen>
+
+This file is part of saturnin.
+
+saturnin is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+saturnin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SATURNIN_LITERALSEARCH_H
+#define	SATURNIN_LITERALSEARCH_H
+
+#include "Assert.h"
+#include "VariablesManager.h"
+#include "WeakBool.h"
+#include "Saturnin.h"
+
+#if !defined(SATURNIN_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+/** The AVX2 version of the search is compiled and used if the cpu allows it */
+#define SATURNIN_SIMD_AVX2
+#endif
+
+namespace saturnin {
+
+    /**
+     * This class contains only static methods used to look for the first
+     * literal of a clause that isn't false. This is the replacement watch
+     * search of the propagation. The values are read from a table indexed by
+     * the literals: values[l] is wTrue if l is true, wFalse if l is false and
+     * wUnknown if its variable isn't assigned.
+     * When the cpu supports it, the literals are tested 8 at a time using
+     * AVX2 gathers. The result is always the same as the scalar search.
+     */
+    class SATURNIN_EXPORT LiteralSearch final {
+    public:
+
+        /**
+         * The number of readable bytes that must follow the value of the last
+         * literal in the value table, as the gathers read 4 bytes per literal
+         */
+        static const unsigned int padding = 3;
+
+        /**
+         * Look for the first literal that isn't false
+         * @param lits the literals of the clause
+         * @param from the position of the first literal to check
+         * @param sz the number of literals in @a lits
+         * @param values the value of each literal followed by @a padding bytes
+         * @return the position of the first literal of @a lits, starting from
+         *         @a from, whose value isn't wFalse or @a sz if every literal
+         *         is false
+         */
+        static inline unsigned int findNonFalse(const Lit* lits, unsigned int from, unsigned int sz, const wbool* values) {
+#ifdef SATURNIN_SIMD_AVX2
+            if (useAVX2 && sz >= from + 8) {
+                return findNonFalseAVX2(lits, from, sz, values);
+            }
+#endif /* SATURNIN_SIMD_AVX2 */
+            return findNonFalseScalar(lits, from, sz, values);
+        }
+
+        /**
+         * The scalar version of findNonFalse
+         * @param lits the literals of the clause
+         * @param from the position of the first literal to check
+         * @param sz the number of literals in @a lits
+         * @param values the value of each literal
+         * @return the position of the first literal whose value isn't wFalse
+         *         or @a sz if every literal is false
+         */
+        static inline unsigned int findNonFalseScalar(const Lit* lits, unsigned int from, unsigned int sz, const wbool* values) {
+            while (from < sz && values[lits[from]] == wFalse) {
+                from++;
+            }
+            return from;
+        }
+
+        /**
+         * The AVX2 version of findNonFalse. It must only be called if
+         * isAVX2Supported returns true
+         * @param lits the literals of the clause
+         * @param from the position of the first literal to check
+         * @param sz the number of literals in @a lits
+         * @param values the value of each literal followed by @a padding bytes
+         * @return the position of the first literal whose value isn't wFalse
+         *         or @a sz if every literal is false
+         */
+        static unsigned int findNonFalseAVX2(const Lit* lits, unsigned int from, unsigned int sz, const wbool* values);
+
+        /**
+         * Check if the AVX2 version of the search can be used
+         * @return true if it was compiled and the cpu supports AVX2
+         */
+        static bool isAVX2Supported();
+
+    private:
+
+        /** Set once to know which version findNonFalse must use */
+        static const bool useAVX2;
+
+        //! @cond Doxygen_Suppress
+        LiteralSearch() = delete;
+        //! @endcond
+
+    };
+
+}
+
+#endif	/* SATURNIN_LITERALSEARCH_H */
@@ -105,6 +105,14 @@ namespace saturnin{
          * @return the winning solver or the first if no winning solver
          */
         Solver& getWinningSolver();
+
+        /**
+         * Retrieve one of the underlying solvers. The solvers only exist
+         * once this parallel solver is initialized
+         * @param i the index of the solver, smaller than the number of threads
+         * @return the solver run by the i-th thread
+         */
+        Solver& getSolver(unsigned int i);
         
         /**
          * stop the underlying solvers
@@ -85,6 +85,10 @@ along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
  * <li>Parallelism. A portfolio can be created. At the moment, it uses a simple
  * diversification scheme (based on the initial phase value) and the clause exportation
  * is done after each conflict, but clause import is done at restarts.</li>
+ * <li>SIMD. On x86 with gcc or clang, the replacement watch search of the
+ * propagation uses AVX2 whenever the cpu supports it (see
+ * \ref saturnin::LiteralSearch). Defining SATURNIN_NO_SIMD keeps only the
+ * scalar version.</li>
  * \section License
  * saturnin is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
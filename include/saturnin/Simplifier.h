@@ -20,6 +20,9 @@ along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef SATURNIN_SIMPLIFIER_H
 #define	SATURNIN_SIMPLIFIER_H
 
+#include <stdint.h>
+#include "Array.h"
+#include "Heap.h"
 #include "Solver.h"
 #include "Saturnin.h"
 
@@ -54,6 +57,15 @@ namespace saturnin{
             return s.addClause(lits, sz, true);
         }
         
+        /**
+         * Add several clauses at once to the simplifier
+         * @param batch the clauses to add, none of them may be empty
+         * @return true if we added the clauses successfully, false otherwise
+         */
+        bool addClauses(const Array<Array<Lit> >& batch){
+            return s.addClauses(batch, true);
+        }
+        
         /**
          * Retrieve the number of variable present in this simplifier
          * @return the number of variable
@@ -81,13 +93,14 @@ namespace saturnin{
         }
         
         /**
-         * Return the list of literal that are present in a binary clause with
+         * Retrieve the list of literal that are present in a binary clause with
          * a given literal @a l
          * @param l a literal we want every binary clause using @a l
-         * @return the list of literals that appear in a binary clause with @a l
+         * @param binaries the array in which the literals that appear in a
+         *        binary clause with @a l will be added
          */
-        const Array<Lit>& getBinaryWith(Lit l) const {
-            return s.getBinaryWith(l);
+        void getBinaryWith(Lit l, Array<Lit>& binaries) const {
+            s.getBinaryWith(l, binaries);
         }
         
         /**
@@ -95,9 +108,18 @@ namespace saturnin{
          * except the binary ones
          * @return the list of initial clauses of size 3+
          */
-        const Array<Clause*>& getInitialClauses() const {
+        const Array<CRef>& getInitialClauses() const {
             return s.getInitialClauses();
         }
+
+        /**
+         * Retrieve a clause stored in the simplifier
+         * @param c the reference of the clause
+         * @return the clause referenced by @a c
+         */
+        const Clause& getClause(CRef c) const {
+            return s.getClause(c);
+        }
         
         /**
          * Return the list of proven literals
@@ -116,6 +138,16 @@ namespace saturnin{
          *        account for the simplification
          */
         void revival(unsigned int minimum = 15);
+
+        /**
+         * Look for the failed literals of the binary implication graph, see
+         * Solver::probe. The equivalences it finds are added as
+         * binary clauses, therefore it must be called before
+         * substituteEquivalences. It relies on every clause being watched,
+         * which revival keeps
+         * @return the state of the simplifier
+         */
+        wbool probe();
         
         /**
          * Retrieve the number of clauses that were reduced by the revival
@@ -125,14 +157,288 @@ namespace saturnin{
         unsigned int getNbClausesReduced() const {
             return nbClausesReduced;
         }
-        
+
+        /**
+         * Retrieve the state of the simplifier
+         * @return wFalse if UNSAT has been proven, wUnknown otherwise
+         */
+        inline wbool getState() const {
+            return s.getState();
+        }
+
+        /**
+         * Prevent a variable from being eliminated, for instance because a
+         * value is presumed for it
+         * @param v the variable to keep
+         */
+        void freeze(Var v);
+
+        /**
+         * Replace the equivalent literals by a single one. Two literals are
+         * equivalent if they imply each other through the binary clauses,
+         * that is, if they belong to the same strongly connected component
+         * of the binary implication graph. Those components are found with
+         * the algorithm of Tarjan. In each of them, the smallest literal
+         * becomes the representative of the others, except for the frozen
+         * variables which are kept. The clauses are rewritten with the
+         * representatives, and the equivalences are pushed on the extension
+         * stack to give a value to the substituted variables.
+         * It must be called before eliminateVariables
+         * @return the number of variables substituted
+         */
+        unsigned int substituteEquivalences();
+
+        /**
+         * Remove the blocked clauses. A clause C is blocked on one of its
+         * literals l if every resolvent of C on l is a tautology. Removing it
+         * keeps the satisfiability, and if a model doesn't satisfy it, l can
+         * be flipped. For more information, feel free to consult the following
+         * publication:
+         * Järvisalo M, Biere A, Heule M, Blocked Clause Elimination
+         * In TACAS 2010, pp 129-144
+         * If @a covered is true, the covered clauses are removed as well: the
+         * literals found in every non tautological resolvent on l are added
+         * to C, which may then become blocked.
+         * The removed clauses are pushed on the extension stack. The frozen
+         * variables are never used as the blocking literal. It must be called
+         * before eliminateVariables
+         * @param covered true to remove the covered clauses as well
+         * @return the number of clauses removed
+         */
+        unsigned int eliminateBlockedClauses(bool covered = false);
+
+        /**
+         * Apply the bounded variable elimination on the clauses of the
+         * simplifier. For more information, feel free to consult the following
+         * publication:
+         * Eén N, Biere A, Effective Preprocessing in SAT Through Variable and
+         * Clause Elimination
+         * In SAT 2005, pp 61-75
+         * The clauses are first copied into occurrence lists. Then, starting
+         * from the variables with the fewest occurrences, a variable is
+         * replaced by its non tautological resolvents as long as there are no
+         * more of them than the clauses they replace and none of them is
+         * longer than maxResolventSize. Once done, the remaining clauses are
+         * given by getClauses and the removed ones by getExtensionStack
+         * @return the number of variables eliminated
+         */
+        unsigned int eliminateVariables();
+
+        /**
+         * Retrieve the clauses left by eliminateVariables, the clauses that
+         * were removed are empty
+         * @return the clauses without the proven literals
+         */
+        const Array<Array<Lit> >& getClauses() const {
+            return elimClauses;
+        }
+
+        /**
+         * Retrieve the clauses removed by eliminateVariables, needed to
+         * extend a model to the eliminated variables. They are stored one
+         * after the other in the order of their removal: the size of the
+         * clause followed by its literals, the first being the literal of the
+         * eliminated variable
+         * @return the extension stack
+         */
+        const Array<Lit>& getExtensionStack() const {
+            return extensionStack;
+        }
+
+        /**
+         * Retrieve the number of variables eliminated by eliminateVariables
+         * @return the number of eliminated variables
+         */
+        unsigned int getNbEliminatedVars() const {
+            return nbEliminatedVars;
+        }
+
+        /**
+         * Retrieve the number of variables replaced by an equivalent literal
+         * by substituteEquivalences
+         * @return the number of substituted variables
+         */
+        unsigned int getNbSubstitutedVars() const {
+            return nbSubstitutedVars;
+        }
+
+        /**
+         * Retrieve the number of clauses removed by eliminateBlockedClauses
+         * @return the number of blocked clauses
+         */
+        unsigned int getNbBlockedClauses() const {
+            return nbBlockedClauses;
+        }
+
+        /**
+         * Retrieve the number of clauses removed by eliminateBlockedClauses
+         * that were blocked only once extended with covered literals
+         * @return the number of covered clauses
+         */
+        unsigned int getNbCoveredClauses() const {
+            return nbCoveredClauses;
+        }
+
     private:
-        
+
+        /**
+         * Copy the clauses of the solver into elimClauses and build the
+         * occurrence lists, if it wasn't done yet. A clause falsified by the
+         * proven literals sets the state to wFalse
+         */
+        void buildOccurrences();
+
+        /**
+         * Compute the representative of each literal, using the strongly
+         * connected components of the binary implication graph
+         * @param representative will contain the representative of each
+         *        literal
+         * @return false if a literal is equivalent to its negation, in which
+         *         case the instance is UNSAT
+         */
+        bool computeRepresentatives(Array<Lit>& representative);
+
+        /**
+         * Add a clause to elimClauses and to the occurrence lists
+         * @param c the literals of the clause
+         */
+        void addElimClause(const Array<Lit>& c);
+
+        /**
+         * Remove a clause from elimClauses and push it on the extension stack
+         * @param idx the index of the clause in elimClauses
+         * @param pivot the literal put first on the extension stack
+         */
+        void removeElimClause(unsigned int idx, Lit pivot);
+
+        /**
+         * Push a clause on the extension stack
+         * @param c the literals of the clause
+         * @param sz the number of literals of @a c to push
+         * @param pivot the literal put first on the extension stack, it must
+         *        be one of the @a sz first literals of @a c
+         */
+        void pushExtension(const Array<Lit>& c, unsigned int sz, Lit pivot);
+
+        /**
+         * Remove a clause from elimClauses without keeping it
+         * @param idx the index of the clause in elimClauses
+         */
+        void clearElimClause(unsigned int idx);
+
+        /**
+         * Replace a variable by its resolvents if it doesn't increase the
+         * number of clauses
+         * @param v the variable to eliminate
+         * @return true if @a v was eliminated
+         */
+        bool eliminate(Var v);
+
+        /**
+         * Compute the resolvent of two clauses
+         * @param a the clause containing the positive literal of @a v
+         * @param b the clause containing the negative literal of @a v
+         * @param v the variable on which the resolution is made
+         * @param resolvent will contain the resolvent
+         * @return false if the resolvent is a tautology
+         */
+        bool resolve(const Array<Lit>& a, const Array<Lit>& b, Var v, Array<Lit>& resolvent);
+
+        /**
+         * Update the position of a variable whose occurrences changed in the
+         * elimination queue
+         * @param v the variable
+         */
+        void touch(Var v);
+
+        /**
+         * This class is used for the elimination queue, the variables with
+         * the fewest possible resolvents come first
+         */
+        class ElimComp {
+        public:
+
+            /**
+             * Create a new ElimComp
+             * @param s the simplifier providing the occurrences of the
+             *          variables
+             */
+            ElimComp(const Simplifier& s) : simp(s) {
+            }
+
+            /**
+             * Compare two elements
+             * @param a the first element to compare
+             * @param b the second element to compare
+             * @return a negative number if @a a lower than @a b, a positive number
+             *         if @a is greater than @b or zero if @a equals @b
+             */
+            inline int64_t compare(const Var a, const Var b) const {
+                return (int64_t) (*this)[a] - (int64_t) (*this)[b];
+            }
+
+            /**
+             * Retrieve the cost of eliminating a variable
+             * @param v the variable
+             * @return the product of the number of occurrences of both
+             *         literals of @a v
+             */
+            inline uint64_t operator[](Var v) const {
+                return (uint64_t) simp.nbOccurs.get(VariablesManager::getLit(v, true)) *
+                        simp.nbOccurs.get(VariablesManager::getLit(v, false));
+            }
+
+        private:
+            /** The simplifier using this ElimComp */
+            const Simplifier& simp;
+        };
+
         /** The solver used to simplify an instance */
         Solver s;
         /** The number of clauses that were reduced */
         unsigned int nbClausesReduced;
-        
+        /** The clauses used by the variable elimination */
+        Array<Array<Lit> > elimClauses;
+        /** For each literal, the indexes of the clauses that may contain it */
+        Array<Array<unsigned int> > occurs;
+        /** For each literal, the number of clauses containing it */
+        Array<unsigned int> nbOccurs;
+        /** The clauses removed by the elimination */
+        Array<Lit> extensionStack;
+        /** The variables that mustn't be eliminated */
+        Array<bool> frozen;
+        /** The variables that were eliminated */
+        Array<bool> eliminated;
+        /** The variables to try to eliminate */
+        Heap<uint64_t, ElimComp> elimQueue;
+        /** The stamp of each literal, used to compute the resolvents */
+        Array<unsigned int> litStamps;
+        /** The last stamp given */
+        unsigned int stamp;
+        /** Whether elimClauses and the occurrence lists were built */
+        bool occurrencesBuilt;
+        /** The number of eliminated variables */
+        unsigned int nbEliminatedVars;
+        /** The number of variables replaced by an equivalent literal */
+        unsigned int nbSubstitutedVars;
+        /** The number of clauses removed by eliminateBlockedClauses */
+        unsigned int nbBlockedClauses;
+        /** The number of those clauses that needed covered literals */
+        unsigned int nbCoveredClauses;
+        /** The maximum size of a resolvent */
+        unsigned int maxResolventSize;
+        /**
+         * The maximum number of occurrences of a variable to try to eliminate
+         * it
+         */
+        unsigned int maxOccurrences;
+        /** The number of literals that may still be visited by resolution */
+        int64_t elimBudget;
+        /** The number of literals that may still be visited to find blocked clauses */
+        int64_t blockedBudget;
+        /** The maximum size of a clause extended with covered literals */
+        unsigned int maxCoveredSize;
+
     };
     
 }
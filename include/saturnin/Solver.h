@@ -22,12 +22,14 @@ along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stddef.h>                     // for size_t
 #include <stdio.h>                      // for fprintf, FILE, stdout
+#include <math.h>                       // for pow
 #include <limits>                       // for numeric_limits
 #include "saturnin/Array.h"             // for Array
 #include "saturnin/Clause.h"            // for Clause, watcher_t
 #include "saturnin/ClauseAllocator.h"   // for ClauseAllocator
-#include "saturnin/Fifo.h"              // for Fifo
+#include "saturnin/ClauseArena.h"       // for ClauseArena
 #include "saturnin/Heap.h"              // for Heap
+#include "saturnin/LiteralSearch.h"     // for LiteralSearch
 #include "saturnin/Mean.h"              // for Mean
 #include "saturnin/SlidingMean.h"       // for SlidingMean
 #include "saturnin/VariablesManager.h"  // for Lit, Var, VariablesManager
@@ -62,6 +64,24 @@ namespace saturnin {
     class SATURNIN_EXPORT Solver final {
     public:
 
+        /** The heuristics that can select the next decision variable */
+        enum class BranchingHeuristic {
+            /** The most active variable according to VSIDS, using a heap */
+            VSIDS,
+            /**
+             * The variable most recently moved to the front of a queue (VMTF)
+             * by the analysis of the conflicts
+             */
+            VMTF,
+            /**
+             * The variable with the highest learning rate (LRB): an
+             * exponential moving average of the proportion of the conflicts
+             * in which it took part while it was assigned. It uses the same
+             * heap as VSIDS
+             */
+            LRB
+        };
+
         /**
          * Create a new Solver
          * @param nbVar the number of variable in the instance we would like
@@ -85,6 +105,10 @@ namespace saturnin {
          * @return the wbool representing the weak boolean value
          */
         inline wbool getVarValue(Var v) const {
+            if (v < model.getSize()) {
+                //the model was extended to the eliminated variables
+                return model[v];
+            }
             if(map[v]==std::numeric_limits<unsigned int>::max()){
                 //the variable v hasn't been used in the problem
                 //therefore, we may give it any value we want
@@ -115,19 +139,27 @@ namespace saturnin {
          * except the binary ones
          * @return the list of initial clauses of size 3+
          */
-        const Array<Clause*>& getInitialClauses() const {
+        const Array<CRef>& getInitialClauses() const {
             return clauses;
         }
+
+        /**
+         * Retrieve a clause stored in this solver
+         * @param c the reference of the clause
+         * @return the clause referenced by @a c
+         */
+        inline const Clause& getClause(CRef c) const {
+            return arena[c];
+        }
         
         /**
-         * Return the list of literal that are present in a binary clause with
+         * Retrieve the list of literal that are present in a binary clause with
          * a given literal @a l
          * @param l a literal we want every binary clause using @a l
-         * @return the list of literals that appear in a binary clause with @a l
+         * @param binaries the array in which the literals that appear in a
+         *        binary clause with @a l will be added
          */
-        const Array<Lit>& getBinaryWith(Lit l) const {
-            return binWatched.get(l);
-        }
+        void getBinaryWith(Lit l, Array<Lit>& binaries) const;
 
         /**
          * Retrieve the initial number of clauses that was described by the
@@ -154,6 +186,52 @@ namespace saturnin {
             return restarts;
         }
 
+        /**
+         * Retrieve the total number of decision levels that were kept during
+         * the restarts instead of being rebuilt
+         * @return the sum over the restarts of the number of levels reused
+         */
+        inline uint64_t getNbReusedLevels() const {
+            return nbReusedLevels;
+        }
+
+        /**
+         * Enable or disable the reuse of the trail during the restarts
+         * @param reuse if true, a restart keeps the decision levels whose
+         *        decision would be taken again
+         */
+        inline void setReuseTrail(bool reuse) {
+            reuseTrail = reuse;
+        }
+
+        /**
+         * Enable or disable the target phases
+         * @param target if true, the decisions take the phases of the longest
+         *        trail without conflict found since the last rephasing
+         *        instead of the last value of the variables
+         */
+        inline void setTargetPhase(bool target) {
+            targetPhases = target;
+        }
+
+        /**
+         * Enable or disable the rephasing. Periodically, the saved phases are
+         * reset to the original, inverted, best or random phases, the best
+         * phases being those of the longest trail without conflict
+         * @param rephase if true, the phases are periodically reset
+         */
+        inline void setRephase(bool rephase) {
+            rephasing = rephase;
+        }
+
+        /**
+         * Retrieve the number of rephasing performed until now
+         * @return the number of times the saved phases were reset
+         */
+        inline uint64_t getNbRephases() const {
+            return nbRephases;
+        }
+
         /**
          * Retrieve the total number of propagation performed until now
          * @return the total number of propagation performed by the solver
@@ -170,6 +248,28 @@ namespace saturnin {
             return conflicts;
         }
 
+        /**
+         * Retrieve the total number of decisions taken until now
+         * @return the total number of decisions taken by the solver
+         */
+        inline uint64_t getNbDecisions() const {
+            return nbDecisions;
+        }
+
+        /**
+         * Select the heuristic used to pick the decision variables
+         * @param h the new heuristic
+         */
+        void setBranchingHeuristic(BranchingHeuristic h);
+
+        /**
+         * Retrieve the heuristic used to pick the decision variables
+         * @return the current heuristic
+         */
+        inline BranchingHeuristic getBranchingHeuristic() const {
+            return branching;
+        }
+
         inline uint64_t getAssignationLevel() const {
             return assignLevel;
         }
@@ -219,6 +319,32 @@ namespace saturnin {
          */
         bool addClause(const Array<Lit>& c);
 
+        /**
+         * Add several clauses at once. It gives the same formula as adding
+         * them one by one with addClause, but the literals of each clause are
+         * sorted by sortLits, the tautologies and the duplicated clauses are
+         * dropped in a single pass, and the watched lists are allocated once
+         * to their final size before being filled. The units of @a batch are
+         * assigned as they are met and propagated once every clause is
+         * watched
+         * @param batch the clauses to add, none of them may be empty
+         * @param mapped boolean telling whether the literals in @a batch
+         *               have already been mapped
+         * @return true if we were able to add the clauses, false if we
+         *              reached an inconsistent state
+         */
+        bool addClauses(const Array<Array<Lit> >& batch, bool mapped = false);
+
+        /**
+         * Add a clause removed by the variable elimination. It isn't used
+         * during the search, only to give a value to the eliminated variables
+         * once a solution has been found
+         * @param literals the literals of the clause, not mapped. The first
+         *                 one is the literal of the eliminated variable
+         * @param sz the size of the array @a literals
+         */
+        void addEliminatedClause(const Lit * const literals, unsigned int sz);
+
         /**
          * Try to solve the instance
          * @param nbRestarts the maximum number of restart allowed
@@ -302,11 +428,11 @@ namespace saturnin {
 
         /**
          * Print the given clause according to the state of this solver
-         * @param c the clause to print
+         * @param c the reference of the clause to print
          * @param color if true, a colored representation will be printed
          * @param out the output file in which we will print the clause @a c
          */
-        void printClause(Clause* c, bool color = true, FILE* out = stdout) const;
+        void printClause(CRef c, bool color = true, FILE* out = stdout) const;
 
         /**
          * Print the given clause according to the state of this solver
@@ -314,7 +440,7 @@ namespace saturnin {
          * @param color if true, a colored representation will be printed
          * @param out the output file in which we will print the clause @a c
          */
-        void printClause(Lit* c, bool color = true, FILE* out = stdout) const;
+        void printClause(const Lit* c, bool color = true, FILE* out = stdout) const;
 
         /**
          * Print the clause database that were given as the instance to solve
@@ -357,6 +483,214 @@ namespace saturnin {
         inline unsigned int getNbReduce() const{
             return nbReducePerformed;
         }
+
+        /**
+         * Enable or disable the vivification of the learnt clauses after
+         * each reduce
+         * @param viv if true, the reduce tries to shorten the learnt clauses
+         *        that it kept
+         */
+        inline void setVivification(bool viv) {
+            vivification = viv;
+        }
+
+        /**
+         * Retrieve the number of literals removed from the learnt clauses by
+         * the vivification
+         * @return the number of literals removed by the vivification
+         */
+        inline uint64_t getNbVivifiedLiterals() const {
+            return nbVivifiedLits;
+        }
+
+        /**
+         * Enable or disable the subsumption of the clauses, performed before
+         * the search and periodically at level 0
+         * @param sub if true, the subsumed clauses are removed and the
+         *        clauses are strengthened by self-subsuming resolution
+         */
+        inline void setSubsumption(bool sub) {
+            subsumption = sub;
+        }
+
+        /**
+         * Retrieve the number of clauses removed as they were subsumed by
+         * another clause
+         * @return the number of subsumed clauses
+         */
+        inline uint64_t getNbSubsumedClauses() const {
+            return nbSubsumedClauses;
+        }
+
+        /**
+         * Retrieve the number of clauses shortened by self-subsuming
+         * resolution
+         * @return the number of strengthened clauses
+         */
+        inline uint64_t getNbStrengthenedClauses() const {
+            return nbStrengthenedClauses;
+        }
+
+        /**
+         * Enable or disable the failed literal probing, performed before the
+         * search and periodically at level 0
+         * @param p if true, the roots of the binary implication graph are
+         *        probed
+         */
+        inline void setProbing(bool p) {
+            probing = p;
+        }
+
+        /**
+         * Retrieve the number of literals proven false by the probing as
+         * their propagation led to a conflict
+         * @return the number of failed literals
+         */
+        inline uint64_t getNbFailedLiterals() const {
+            return nbFailedLiterals;
+        }
+
+        /**
+         * Retrieve the number of literals proven by the probing as they are
+         * implied by both polarities of a probed variable
+         * @return the number of implied units
+         */
+        inline uint64_t getNbProbedUnits() const {
+            return nbProbedUnits;
+        }
+
+        /**
+         * Retrieve the number of equivalences found by the probing, each of
+         * them being added as binary clauses
+         * @return the number of equivalences
+         */
+        inline uint64_t getNbProbedEquivalences() const {
+            return nbProbedEquivalences;
+        }
+
+        /**
+         * Retrieve the number of hyper-binary resolvents added by the probing
+         * @return the number of binary clauses added by the hyper-binary
+         *         resolution
+         */
+        inline uint64_t getNbHyperBinaries() const {
+            return nbHyperBinaries;
+        }
+
+        /**
+         * Enable or disable the removal of the transitive binary clauses,
+         * performed after each probing
+         * @param t if true, the binary clauses implied by the other binary
+         *        clauses are removed
+         */
+        inline void setTransitiveReduction(bool t) {
+            transitiveReduction = t;
+        }
+
+        /**
+         * Retrieve the number of binary clauses removed as they were implied
+         * by the other binary clauses
+         * @return the number of transitive binary clauses removed
+         */
+        inline uint64_t getNbTransitiveBinaries() const {
+            return nbTransitiveBinaries;
+        }
+
+        /**
+         * Enable or disable the minimization of the learnt clauses with the
+         * binary clauses of the asserting literal
+         * @param b if true, the learnt clauses are also minimized with the
+         *        binary clauses
+         */
+        inline void setBinaryMinimization(bool b) {
+            binaryMinimization = b;
+        }
+
+        /**
+         * Retrieve the number of literals removed from the learnt clauses by
+         * the recursive minimization
+         * @return the number of literals removed by the recursive minimization
+         */
+        inline uint64_t getNbMinimizedLits() const {
+            return nbMinimizedLits;
+        }
+
+        /**
+         * Retrieve the number of literals removed from the learnt clauses
+         * with the binary clauses of the asserting literal
+         * @return the number of literals removed by the binary minimization
+         */
+        inline uint64_t getNbBinaryMinimizedLits() const {
+            return nbBinaryMinimizedLits;
+        }
+
+        /**
+         * Enable or disable the on the fly subsumption: during the analysis,
+         * a reason subsumed by the current resolvent loses the literal it
+         * propagated
+         * @param o if true, the subsumed reasons are strengthened
+         */
+        inline void setOnTheFlySubsumption(bool o) {
+            onTheFlySubsumption = o;
+        }
+
+        /**
+         * Retrieve the number of reasons strengthened by the on the fly
+         * subsumption
+         * @return the number of clauses strengthened during the analysis
+         */
+        inline uint64_t getNbOnTheFlyStrengthened() const {
+            return nbOnTheFlyStrengthened;
+        }
+
+        /**
+         * Retrieve the number of conflicts for which a strengthened reason was
+         * the learnt clause, which therefore wasn't added
+         * @return the number of learnt clauses replaced by a strengthened
+         *         reason
+         */
+        inline uint64_t getNbOnTheFlyLearnt() const {
+            return nbOnTheFlyLearnt;
+        }
+        
+        /**
+         * Retrieve the number of times the clauses were relocated into a new
+         * arena
+         * @return the number of garbage collections performed
+         */
+        inline unsigned int getNbGarbageCollect() const{
+            return nbGarbageCollect;
+        }
+
+        /**
+         * Set the threshold of the chronological backtracking. Whenever the
+         * backjump after a conflict would remove more levels than this
+         * threshold, only the last level is removed and the learnt clause is
+         * propagated at the level of its literals. 0 disables the
+         * chronological backtracking, which is the default.
+         * @param threshold the maximum number of levels of a backjump
+         */
+        inline void setChronologicalBacktrack(unsigned int threshold){
+            chronoThreshold = threshold;
+        }
+
+        /**
+         * Retrieve the threshold of the chronological backtracking
+         * @return the maximum number of levels of a backjump, 0 if the
+         *         chronological backtracking is disabled
+         */
+        inline unsigned int getChronologicalBacktrack() const{
+            return chronoThreshold;
+        }
+
+        /**
+         * Retrieve the number of conflicts after which only one level was
+         * removed instead of backjumping
+         * @return the number of chronological backtracks performed
+         */
+        inline uint64_t getNbChronologicalBacktrack() const{
+            return nbChronoBacktrack;
+        }
         
         /**
          * Retrieve the number of clauses that were removed
@@ -367,11 +701,11 @@ namespace saturnin {
         }
 
         /**
-         * Retrieve the allocator used by this solver
-         * @return the allocator used by this solver
+         * Retrieve the arena holding the clauses of this solver
+         * @return the arena used by this solver
          */
-        const ClauseAllocator& getAllocator() const{
-            return allocator;
+        const ClauseArena& getArena() const{
+            return arena;
         }
 
         /**
@@ -448,17 +782,24 @@ namespace saturnin {
 
 #ifdef PROFILE
 
-        /** number of cycles spent in propagateMonoWatched*/
-        uint64_t __profile_propagateMono;
-        /** number of cycles spent in binaryPropagate*/
-        uint64_t __profile_propagateBin;
         /** number of cycles spent in propagateWatchedBy*/
-        uint64_t __profile_propagateWatched;
+        uint64_t __profile_propagate;
         /** number of cycles spent in reduce*/
         uint64_t __profile_reduce;
         /** number of cycles spent in analyze*/
         uint64_t __profile_analyze;
         uint64_t __profile_simplify;
+        /** number of cycles spent to pick the decision variables */
+        uint64_t __profile_decide;
+        /** number of cycles spent in subsume */
+        uint64_t __profile_subsume;
+        /** number of cycles spent in probe and reduceTransitive */
+        uint64_t __profile_probe;
+        /**
+         * number of watchers visited in propagateWatchedBy, indexed by the
+         * kind of the watcher
+         */
+        uint64_t __profile_visits[4];
 
 #endif /* PROFILE */
 
@@ -468,24 +809,21 @@ namespace saturnin {
         /**
          * Retrieve the weak boolean value of a given literal
          * @param l the literal we would like to know it's value
-         * @return the wbool representing the weak boolean value
+         * @return the wbool representing the weak boolean value, wUnknown if
+         *         the variable of @a l isn't assigned
          */
         inline wbool getLitValue(Lit l) const {
-            ASSERT(assign[VariablesManager::getVar(l)] != wUnknown);
-            wbool w = assign[VariablesManager::getVar(l)];
-            if(VariablesManager::getLitSign(l) == false){
-                w = w == wTrue ? wFalse : wTrue;
-            }
-            return w;
+            return litValues[l];
         }
 
         /**
          * Treat a conflicting clause
          * @param c the conflicting clause. The literal array should end with
          *          a lit_Undef
-         * @return the learnt clause if it's size is greater than 2
+         * @return the reference of the learnt clause if it's size is greater
+         *         than 2, CRef_Undef otherwise
          */
-        Clause* treatConflict(Lit* c);
+        CRef treatConflict(Lit* c);
         
         /**
          * Ensure that we have enough capacity in order to use the given
@@ -496,6 +834,35 @@ namespace saturnin {
          */
         void ensureCapacity(Var v, unsigned int nbInitialized);
 
+        /**
+         * Give the internal literal of a literal of the instance. The
+         * variable is mapped to the next free one the first time it is seen
+         * @param l the literal of the instance
+         * @return the literal used by the solver
+         */
+        Lit mapLit(Lit l);
+
+        /**
+         * Assign a unit clause at level 0 without propagating it
+         * @param l the literal of the unit clause, already mapped
+         * @return false if ¬l was already proven
+         */
+        bool assignUnit(Lit l);
+
+        /**
+         * Propagate the units assigned at level 0
+         * @return false if a conflict was found, the formula is then UNSAT
+         */
+        bool propagateUnits();
+
+        /**
+         * Sort the literals of a clause by increasing value. The short clauses
+         * are sorted by insertion, the others by a radix sort on each byte
+         * @param lits the literals to sort
+         * @param sz the number of literals
+         */
+        static void sortLits(Lit* lits, unsigned int sz);
+
         /**
          * Search for a solution
          * @param maxConflict the maximum number of conflict allowed
@@ -522,36 +889,156 @@ namespace saturnin {
         void reduce();
 
         /**
-         * Propagate every literal that is in the waiting queue
-         * @return the pointer to the clause leading to a conflict
-         */
-        Lit* propagate();
+         * Try to shorten the attached learnt clauses that weren't vivified
+         * yet, those with the smallest lbd first. For each clause, the
+         * negation of its literals are decided one after the other: a
+         * literal found false can be removed, and a literal found true or a
+         * conflict allows to drop the remaining literals. The propagations
+         * are limited to a fraction of those made since the last call.
+         * It must be called at level 0
+         * @param maxLBD the maximum lbd of the clauses to vivify
+         * @return the number of literals removed
+         */
+        unsigned int vivifyLearntClauses(unsigned int maxLBD);
+
+        /**
+         * Add a learnt clause that replaces a longer one. It must be called
+         * at level 0, when no literal of @a lits is assigned
+         * @param lits the literals of the clause, at least 3
+         * @param lbd the lbd of the replaced clause
+         * @return the reference of the new clause
+         */
+        CRef addShorterLearntClause(const Array<Lit>& lits, unsigned int lbd);
+
+        /**
+         * Remove the clauses subsumed by another one and strengthen the
+         * clauses by self-subsuming resolution. For more information, feel
+         * free to consult the following publication:
+         * Eén N, Biere A, Effective Preprocessing in SAT Through Variable and
+         * Clause Elimination
+         * In SAT 2005, pp 61-75
+         * The clauses are visited by increasing size. A clause is checked
+         * against the binary clauses and the clauses already visited, each of
+         * them being in the occurrence list of a single of its literals.
+         * The 64 bits signatures of the clauses discard most of the pairs
+         * without looking at their literals. A learnt clause can't subsume
+         * an initial one as it may be removed later, but it can strengthen
+         * it. The number of literals visited is limited by subsumeBudget.
+         * It must be called at level 0
+         * @return the state of the solver
+         */
+        wbool subsume();
+
+        /** A variable in the tree of the implications of a probed literal */
+        struct ProbeNode {
+            /** The closest common ancestor of the literals of the reason */
+            Lit parent;
+            /** The distance to the probed literal */
+            unsigned int depth;
+            /** Whether the variable was implied through binary clauses only */
+            bool binary;
+        };
 
         /**
-         * Propagate binary clauses
+         * Probe the variables of the binary implication graph. For a root of
+         * the graph, only the literal implying others is propagated, the
+         * other one would propagate nothing. For the other variables, both
+         * literals are propagated in turn:
+         * - if one of them leads to a conflict, the other one is proven;
+         * - a literal implied by both of them is proven;
+         * - a literal implied by one of them, whose opposite is implied by the
+         *   other one, is equivalent to the negation of the probed variable.
+         *   Unless both implications are made of binary clauses, the
+         *   equivalence is added as binary clauses, so that it can be found
+         *   by the substitution of the equivalent literals.
+         * The literals implied by a ternary or long clause also give a
+         * hyper-binary resolvent, see probeLiteral.
+         * The variables are visited in turn, starting from where the last
+         * probing stopped, until probeBudget propagations were made.
+         * It must be called at level 0
+         * @return the state of the solver
+         */
+        wbool probe();
+
+        /**
+         * Propagate a literal at a new level, used by the probing. The
+         * implied literals form a tree, the parent of a literal being the
+         * closest common ancestor of the literals of its reason. When a
+         * literal m is implied by a clause with several implied literals, its
+         * parent d gives the hyper-binary resolvent -d m, which is shorter
+         * than the clause. For more information, feel free to consult the
+         * following publication:
+         * Gershman R, Strichman O, HaifaSat: A New Robust SAT Solver
+         * In HVC 2005, pp 76-89
          * @param l the literal to propagate
-         * @return the pointer to the clause leading to a conflict, if any,
-         *         nullptr otherwise
+         * @param implied will contain the literals implied by @a l
+         * @param resolvents will contain the hyper-binary resolvents, two
+         *        literals by clause
+         * @param tree the node of each variable in the tree of the
+         *        implications
+         * @return false if @a l leads to a conflict
          */
-        Lit* binaryPropagate(const Lit l);
+        bool probeLiteral(Lit l, Array<Lit>& implied, Array<Lit>& resolvents, Array<ProbeNode>& tree);
 
         /**
-         * Propagate clauses of size > 2 that are using the 2 literal watched
-         * scheme
-         * @param l one of the two watchers, the literal we are propagating on
-         * @return the pointer to the clause leading to a conflict, if any,
-         *         nullptr otherwise
+         * Add the hyper-binary resolvents found by probeLiteral that don't
+         * exist yet
+         * @param resolvents the resolvents, two literals by clause
          */
-        Lit* propagateWatchedBy(const Lit l);
+        void addHyperBinaryResolvents(const Array<Lit>& resolvents);
 
         /**
-         * Propagate clauses of size > 2 that are using only 1 watched literal
-         * Those clauses are the 'frozen' ones
-         * @param l the literal to propagate
+         * Remove the binary clauses implied by the other binary clauses. The
+         * clause a b, that is the implication -a -> b, is removed if b can be
+         * reached from -a without it. Reaching a proves a instead.
+         * The literals are visited in turn, starting from where the last
+         * reduction stopped, until transitiveBudget binary watchers were
+         * visited. It must be called at level 0
+         * @return the state of the solver
+         */
+        wbool reduceTransitive();
+
+        /**
+         * Remove a binary clause from the watches
+         * @param a the first literal of the clause
+         * @param b the second literal of the clause
+         */
+        void removeBinaryClause(Lit a, Lit b);
+
+        /**
+         * Check if a binary clause exists
+         * @param a the first literal of the clause
+         * @param b the second literal of the clause
+         * @return true if the binary clause @a a \/ @a b exists
+         */
+        bool hasBinaryClause(Lit a, Lit b) const;
+
+        /**
+         * Move every live clause into a new arena, releasing the memory of the
+         * removed ones. The clauses are copied in the order they are reached
+         * from the watch lists, so that the clauses visited while propagating
+         * a literal are close to each other in memory.
+         * It may only be called at level 0
+         */
+        void garbageCollect();
+
+        /**
+         * Propagate every literal of the stack that hasn't been propagated
+         * yet, starting from propagationHead
+         * @return the pointer to the clause leading to a conflict
+         */
+        Lit* propagate();
+
+        /**
+         * Propagate every clause watched by a given literal in a single pass
+         * over its watch list: binary clauses, clauses of size > 2 that are
+         * using the 2 literal watched scheme and the 'frozen' clauses that
+         * are watched by only one literal
+         * @param l the literal to propagate, it has just been assigned false
          * @return the pointer to the clause leading to a conflict, if any,
          *         nullptr otherwise
          */
-        Lit* propagateMonoWatched(const Lit l);
+        Lit* propagateWatchedBy(const Lit l);
 
         /**
          * Analyze the reason of a conflict and fill the array with a clause
@@ -580,7 +1067,7 @@ namespace saturnin {
          * @return the abstract level of this variable
          */
         inline unsigned int abstractLevel(Var v) const {
-            return 1 << (varLevel.get(v) & 31);
+            return 1 << (varData.get(v).level & 31);
         }
 
         /**
@@ -592,53 +1079,203 @@ namespace saturnin {
          */
         bool litRedundant(Lit p, unsigned int abstract_levels, Array<Lit>& analyze_toclear);
 
+        /**
+         * Remove from a learnt clause the literals whose negation is implied
+         * by the negation of the asserting literal through a binary clause:
+         * resolving with the binary clause gives the clause without them.
+         * Only the clauses of at most binaryMinimizationSize literals and
+         * binaryMinimizationLBD levels are minimized this way
+         * @param learnt the learnt clause, its first literal is the asserting
+         *        one. The seen flag of every variable must be cleared
+         */
+        void minimizeWithBinaries(Array<Lit>& learnt);
+
+        /**
+         * Remove their pivot from the reasons found subsumed by a resolvent
+         * during the last analysis. It must be called once the solver
+         * backtracked, before anything is propagated. A reason is only
+         * strengthened if it is still watched by two literals that aren't
+         * false, except the one equal to @a learnt which is watched by its
+         * first two literals
+         * @param learnt the clause learnt by the last analysis
+         * @return the reference of the strengthened reason equal to
+         *         @a learnt, which may propagate its first literal instead of
+         *         adding @a learnt, or CRef_Undef
+         */
+        CRef strengthenReasons(const Array<Lit>& learnt);
+
         /**
          * Enqueue the literal l for propagation
          * @param l the literal that was proven/decided to be true at the
          *          current decision level
          * @param reason the clause that led to enqueue the literal l. If
-         *               nullptr, it means that either l was proven or l is
-         *               is based on a decision variable
+         *               CRef_Undef, it means that either l was proven or l
+         *               is based on a decision variable. If binaryReason,
+         *               the reason is the binary or ternary clause stored in
+         *               binReasons
          */
-        void enqueue(Lit l, Lit* reason = nullptr);
+        void enqueue(Lit l, CRef reason = CRef_Undef);
+
+        /**
+         * Retrieve the reason of the assignation of a given variable
+         * @param v the variable
+         * @return the literals of the clause that led to the assignation of
+         *         @a v, ending with lit_Undef, or nullptr if @a v was decided
+         *         or proven
+         */
+        inline Lit* getReason(Var v) {
+            CRef r = varData[v].reason;
+            if (r == CRef_Undef) {
+                return nullptr;
+            } else if (r == binaryReason) {
+                return ((Lit*) binReasons) + 4 * v;
+            }
+            return arena[r].lits();
+        }
 
         /**
          * Backtrack a given number of levels. The reason why a backtrack would
          * fail is that we try to revert something that was proven and therefore
-         * the problem must be UNSAT
+         * the problem must be UNSAT.
+         * With the chronological backtracking, the literals that were implied
+         * at one of the remaining levels are kept on the stack and will be
+         * propagated again.
          * @param nbLvl the number of levels to backtrack
          * @return true if we could backtrack, false if we couldn't. 
          */
         bool backtrack(unsigned int nbLvl);
 
+        /**
+         * Save the phases of the levels below the current one in the target
+         * phases, and in the best phases, if they form a longer trail than
+         * the one already saved. It must be called at a conflict, before the
+         * analysis
+         */
+        void updateTargetPhase();
+
+        /**
+         * Reset the saved and target phases to the next phases of the
+         * rephasing cycle: original, best, inverted, best, random, best
+         */
+        void rephase();
+
+        /**
+         * Compute the number of decision levels that can be kept during a
+         * restart: the decisions of those levels are more active than the
+         * variable that would be picked first after backtracking to level 0,
+         * therefore they would be taken again in the same order.
+         * The assigned variables found at the top of the activity heap are
+         * removed from it.
+         * @return the number of levels, starting from level 1, that a restart
+         *         can keep
+         */
+        unsigned int getReusableLevels();
+
+        /**
+         * Retrieve the highest level of the literals of a clause
+         * @param c the literals of the clause, ending with lit_Undef. Each of
+         *          them must be assigned
+         * @return the highest level at which a literal of @a c was assigned
+         */
+        inline unsigned int getMaxLevel(const Lit* c) const {
+            unsigned int lvl = 0;
+            for (; *c != lit_Undef; c++) {
+                unsigned int l = varData[VariablesManager::getVar(*c)].level;
+                lvl = l > lvl ? l : lvl;
+            }
+            return lvl;
+        }
+
         /**
          * Add the given clause to the set of learnt clauses.
          * If the learnt clause is one literal, it will be added to the
          * propagation.
          * @param clause the Array containing the literals that represent the
          *        literals of the clause to add
-         * @return the pointer to the clause representation of  @a clause
+         * @return the reference of the clause representation of @a clause,
+         *         CRef_Undef if @a clause contains less than 3 literals
          */
-        Clause* addLearntClause(const Array<Lit>& clause);
+        CRef addLearntClause(const Array<Lit>& clause);
         
         /**
-         * Remove a learnt clause from the learnt database
-         * @param c the clause that we will remove
+         * Remove a learnt clause from the learnt database. If the clause is
+         * attached, its watchers are only dropped by the next walk over the
+         * watch lists
+         * @param c the reference of the clause that we will remove
+         */
+        void removeLearntClause(CRef c);
+
+        /**
+         * Remove an initial clause from the watch lists and release it. The
+         * watchers are only dropped by the next call to cleanWatches
+         * @param c the reference of the clause that we will remove
+         */
+        void removeClause(CRef c);
+
+        /**
+         * Drop the watchers of the clauses marked as removed and release
+         * those clauses, in one walk over every watch list. The watchers of
+         * the removed ternary clauses are dropped by walking only the watch
+         * lists of their literals
          */
-        void removeLearntClause(Clause* c);
+        void cleanWatches();
+
+        /**
+         * Release the clauses marked as removed once their watchers have
+         * been dropped
+         */
+        void releaseRemovedClauses();
         
         /**
          * Remove a given clause from the watched list for the given literal
          * @param l one of the watched literals of clause @a c
          * @param c the clause that we want to remove from the watched list
          */
-        void stopWatchClause(const Lit l, const Clause* c);
+        void stopWatchClause(const Lit l, const CRef c);
         
         /**
-         * Add the given clause to the watched list
+         * Add the given clause to the watched list. The initial ternary
+         * clauses are watched by each of their literals with both other
+         * literals inline, the other clauses by their two first literals
          * @param c the clause we will add to the list of watched clause
          */
-        void addWatchedClause(Clause* c);
+        void addWatchedClause(CRef c);
+
+        /**
+         * Remove the given clause from every watch list it belongs to
+         * @param c the clause that was added through addWatchedClause
+         */
+        void detachClause(CRef c);
+
+        /**
+         * Check if a given clause is watched through ternary watchers
+         * @param c the clause
+         * @return true if @a c is an initial clause of size 3
+         */
+        static inline bool isTernaryWatched(const Clause& c) {
+            return c.getSize() == 3 && !c.isLearnt();
+        }
+
+        /**
+         * Check if a watcher of a long clause found in the watch list of a
+         * given literal is still to be kept
+         * @param c the clause referred to by the watcher
+         * @param l the literal whose watch list holds the watcher
+         * @return true if @a c is not removed and @a l is one of its two
+         * watched literals
+         */
+        static inline bool isWatching(const Clause& c, Lit l) {
+            return !c.isToRemove() && (c.getLit(0) == l || c.getLit(1) == l);
+        }
+
+        /**
+         * Add the binary clause (@a a, @a b) to the watched lists. The binary
+         * watchers are kept in front of the others so that they are visited
+         * first during the propagation.
+         * @param a the first literal of the binary clause
+         * @param b the second literal of the binary clause
+         */
+        void addBinaryWatch(const Lit a, const Lit b);
 
         /**
          * Update the the variable state independent decaying sum (VSIDS) of a
@@ -647,6 +1284,72 @@ namespace saturnin {
          */
         void updateVSIDS(Var v);
 
+        /**
+         * Increase the score of a variable that was involved in a conflict,
+         * according to the current branching heuristic
+         * @param v the variable to bump
+         */
+        inline void bumpVariable(Var v) {
+            if (branching == BranchingHeuristic::VSIDS) {
+                updateVSIDS(v);
+            } else if (branching == BranchingHeuristic::VMTF) {
+                vmtfBumped.push(v);
+            } else {
+                lrbData[v].participated++;
+            }
+        }
+
+        /**
+         * Retrieve the next decision variable according to the current
+         * branching heuristic
+         * @return an unassigned variable or var_Undef if every variable is
+         *         assigned
+         */
+        Var pickBranchVar();
+
+        /**
+         * Put a variable at the end of the VMTF queue, with a new timestamp
+         * @param v the variable, which mustn't be in the queue
+         */
+        void vmtfAppend(Var v);
+
+        /**
+         * Move the variables bumped during the last analysis to the end of
+         * the VMTF queue, keeping their relative order
+         */
+        void vmtfFlushBumps();
+
+        /**
+         * Start the LRB interval of a variable that has just been assigned
+         * @param v the assigned variable
+         */
+        void lrbAssign(Var v);
+
+        /**
+         * End the LRB interval of a variable that has just been unassigned
+         * and update its learning rate
+         * @param v the unassigned variable
+         */
+        void lrbUnassign(Var v);
+
+        /**
+         * Apply to the learning rate of a variable the decay of the conflicts
+         * that occured since it was unassigned
+         * @param v the variable
+         * @return true if the learning rate of @a v was changed
+         */
+        bool lrbDecay(Var v);
+
+        /**
+         * Retrieve the decay of a learning rate after some conflicts
+         * @param age the number of conflicts
+         * @return lrbDecayFactor to the power of @a age
+         */
+        inline double getLrbDecay(uint64_t age) const {
+            return age < lrbDecays.getSize() ? lrbDecays.get((unsigned int) age) :
+                    pow(lrbDecayFactor, (double) age);
+        }
+
         /**
          * Check the validity of a set of clause according to an given state
          * @param set the array containing the set of clauses that we want to 
@@ -654,7 +1357,7 @@ namespace saturnin {
          * @param interpretation the interpretation for the variables
          * @return true if the set of clause is satisfied, false otherwise
          */
-        bool checkClauseSetSatifiability(const Array<Clause*>& set,
+        bool checkClauseSetSatifiability(const Array<CRef>& set,
                 const Array<wbool>& interpretation) const;
 
         /**
@@ -722,6 +1425,18 @@ namespace saturnin {
                 return solver.varActivityValue.get(b) - solver.varActivityValue.get(a);
             }
 
+            /**
+             * Compare two activities stored in the heap
+             * @param a the activity of the first element
+             * @param b the activity of the second element
+             * @return a negative number if @a a is more active than @a b, a
+             *         positive number if it is less active or zero if both
+             *         are equals
+             */
+            inline double compareKeys(const double a, const double b) const {
+                return b - a;
+            }
+
             /**
              * Retrieve the value associated with a given key
              * @param key the key we want its value
@@ -736,12 +1451,33 @@ namespace saturnin {
             const Solver& solver;
         };
 
+        /**
+         * The data of a variable that are read together by the analysis and
+         * written together by enqueue and backtrack. Keeping them in the same
+         * 8 bytes means a single cache line per variable instead of one per
+         * array
+         */
+        struct VarData {
+            /** The reason of the assignation of the variable */
+            CRef reason;
+            /** The level at which the variable has been assigned */
+            unsigned int level : 31;
+            /** Whether the variable has been seen during the analysis */
+            unsigned int seen : 1;
+        };
+
         /** The number of variable in the instance we are trying to solve */
         unsigned int nbVar;
-        /** The level at which each variable has been assigned */
-        Array<unsigned int> varLevel;
+        /** The reason, level and analysis mark of each variable */
+        Array<VarData> varData;
         /** The array containing the assignation of the variables */
         Array<wbool> assign;
+        /**
+         * The value of each literal, followed by LiteralSearch::padding
+         * unused values. It is kept in sync with assign so that checking the
+         * value of a literal is a single load
+         */
+        Array<wbool> litValues;
         /** The presumption array: we presume the value of a given variable */
         Array<wbool> presumption;
         /** The array containing the phase of the variables */
@@ -756,6 +1492,33 @@ namespace saturnin {
          * distance is the number of variable having a phase different.
          */
         unsigned int phaseHammingDistance;
+        /**
+         * The phases of the longest trail without conflict found since the
+         * last rephasing
+         */
+        Array<wbool> targetPhase;
+        /**
+         * The phases of the longest trail without conflict found since the
+         * last rephasing using them
+         */
+        Array<wbool> bestPhase;
+        /** The number of literals of the trail saved in targetPhase */
+        unsigned int targetTrailSize;
+        /** The number of literals of the trail saved in bestPhase */
+        unsigned int bestTrailSize;
+        /** Whether the decisions use the target phases */
+        bool targetPhases;
+        /** Whether the phases are periodically reset */
+        bool rephasing;
+        /** The number of rephasing performed */
+        uint64_t nbRephases;
+        /** The number of conflicts at which the next rephasing happens */
+        uint64_t nextRephase;
+        /**
+         * The number of conflicts between the first two rephasing. The next
+         * intervals grow arithmetically
+         */
+        unsigned int rephaseInterval;
         /**
          * This array will provide for each variable the id of the reduce
          * when we last enqueued it
@@ -771,30 +1534,42 @@ namespace saturnin {
         /** The current minimal deviation found */
         double minDeviation;
         /**
-         * The array containing the binary clauses for reasons
+         * The array containing the binary and ternary clauses for reasons
          * It is arranged the following way:
-         * |3*n  | a literal l whose variable is n
-         * |3*n+1| the other literal that led to assigning l
-         * |3*n+2| the largest unsigned int, to let the algorithms know that
+         * |4*n  | a literal l whose variable is n
+         * |4*n+1| the other literal that led to assigning l
+         * |4*n+2| the third literal of a ternary clause, or the largest
+         *             unsigned int for a binary clause
+         * |4*n+3| the largest unsigned int, to let the algorithms know that
          *             the clause has ended
          */
         Array<Lit> binReasons;
-        /** The conflicting clause */
-        Lit binConflict[3];
+        /** The conflicting binary or ternary clause */
+        Lit binConflict[4];
         /** The number of binary clauses */
         unsigned int nbBin;
-        /** The array containing the reason to the choice of sign of a variable*/
-        Array<Lit*> reasons;
-        /** This array represent the occurrence list for binary clauses */
-        Array<Array<Lit> > binWatched;
-        /** The first non-binary clause watched by each literal */
-        Array<Array<watcher_t> > watchedClauses;
-        /** This array contains the clauses that are watched by only 1 literal */
-        Array<Array<watcher_t> > monowatch;
+        /**
+         * The reason value telling that a variable was propagated by the
+         * binary or ternary clause stored in binReasons
+         */
+        static const CRef binaryReason = CRef_Undef - 1;
+        /**
+         * The watch list of each literal. It contains the binary clauses, the
+         * initial ternary clauses, the clauses of size 3+ watched by 2
+         * literals and the clauses that are watched by only 1 literal (the
+         * frozen ones)
+         */
+        Array<Array<watcher_t> > watches;
         /** The value of the variable activity for each variable */
         Array<double> varActivityValue;
-        /** The heap containing the activity of the variables */
-        Heap<Var, VSIDSComp> varActivity;
+        /**
+         * The heap containing the activity of the variables. It is a 4-ary
+         * heap keeping a copy of the activities, so that the comparisons of
+         * percolateDown stay in the heap array
+         */
+        Heap<double, VSIDSComp, 4, true> varActivity;
+        /** The variables unassigned by a backtrack, added at once to the heap */
+        Array<Var> unassignedVars;
         /** 
          * The value that will be added to the activity of a variable whenever
          * we need to increment its activity
@@ -805,21 +1580,128 @@ namespace saturnin {
          * we are using the following value
          */
         double vsidsDec;
+
+        /** The links of a variable in the VMTF queue */
+        struct VmtfLink {
+            /** The previous variable in the queue, var_Undef for the first */
+            Var prev;
+            /** The next variable in the queue, var_Undef for the last */
+            Var next;
+            /** The time at which the variable was moved to the end */
+            uint64_t stamp;
+        };
+
+        /** The heuristic used to pick the decision variables */
+        BranchingHeuristic branching;
+        /** The VMTF queue, the variables at the end are decided first */
+        Array<VmtfLink> vmtfLinks;
+        /** The first variable of the VMTF queue */
+        Var vmtfFirst;
+        /** The last variable of the VMTF queue */
+        Var vmtfLast;
+        /**
+         * The variable where the search for an unassigned variable starts:
+         * every variable after it in the queue is assigned
+         */
+        Var vmtfSearch;
+        /** The last timestamp given in the VMTF queue */
+        uint64_t vmtfStamp;
+        /** The variables bumped during the current analysis */
+        Array<Var> vmtfBumped;
+
+        /** The statistics of a variable used by LRB */
+        struct LrbData {
+            /** The number of conflicts when the variable was assigned */
+            uint64_t assigned;
+            /** The number of conflicts when the variable was unassigned */
+            uint64_t unassigned;
+            /** The number of conflicts involving the variable since then */
+            uint32_t participated;
+            /**
+             * The number of learnt clauses since then whose literals were
+             * implied using the variable
+             */
+            uint32_t reasoned;
+        };
+
+        /**
+         * A ternary watcher of a removed initial ternary clause: the watched
+         * literal and the two inline ones, the smallest first
+         */
+        struct RemovedTernary {
+            /** The literal whose watch list contains the watcher */
+            Lit watched;
+            /** The smallest of the two inline literals */
+            Lit a;
+            /** The largest of the two inline literals */
+            Lit b;
+            /** Whether a watcher was already dropped for this entry */
+            bool dropped;
+
+            /** Order the entries by watched literal, then inline literals */
+            inline bool operator<(const RemovedTernary& o) const {
+                return watched < o.watched || (watched == o.watched &&
+                        (a < o.a || (a == o.a && b < o.b)));
+            }
+        };
+
+        /**
+         * A clause in the occurrence lists of the subsumption. The entries of
+         * all the lists are stored in a single array, each list being linked
+         * through the next field
+         */
+        struct SubsumeEntry {
+            /** The signature of the clause: one bit per variable modulo 64 */
+            uint64_t signature;
+            /** The reference of the clause */
+            CRef ref;
+            /** The position of the next entry of the list, or UINT_MAX */
+            unsigned int next;
+            /** Whether the clause is a learnt one */
+            bool learnt;
+        };
+
+        /** The LRB statistics of each variable */
+        Array<LrbData> lrbData;
+        /**
+         * The weight of the last interval in the learning rate. It decreases
+         * with the conflicts down to lrbMinStep
+         */
+        double lrbStep;
+        /** The lowest value of lrbStep */
+        double lrbMinStep;
+        /**
+         * The decay of the learning rate of an unassigned variable for each
+         * conflict
+         */
+        double lrbDecayFactor;
+        /** The powers of lrbDecayFactor, to avoid calling pow for each
+         * assignment */
+        Array<double> lrbDecays;
+        /** The total number of decisions */
+        uint64_t nbDecisions;
         /** The array containing all given clauses */
-        Array<Clause*> clauses;
+        Array<CRef> clauses;
         /** The array containing every learnt clauses */
-        Array<Clause*> learntClauses;
+        Array<CRef> learntClauses;
+        /** The clauses marked as removed whose watchers weren't dropped yet */
+        Array<CRef> removedClauses;
         /**
-         * Propagation queue. This queue will contains the fact that were
-         * discovered to be false with the current assignations.
+         * The watchers of the removed initial ternary clauses that weren't
+         * dropped yet, three per clause
          */
-        Fifo<Lit> propagationQueue;
+        Array<RemovedTernary> removedTernaries;
         /** 
          * The queue representing the different literals that were choosen to
          * be true, and those who where propagate. Last choosen/propagated will
          * be on top
          */
         Array<Lit> stack;
+        /**
+         * The position in stack of the first literal that hasn't been
+         * propagated yet. The literals after it form the propagation queue
+         */
+        unsigned int propagationHead;
         /**
          * The position of the stack pointer at the beginning of each
          * assignation level. Helpfull for backtracking
@@ -827,6 +1709,18 @@ namespace saturnin {
         Array<Lit> stackPointer;
         /** The current assignation level */
         unsigned int assignLevel;
+        /**
+         * The maximum number of levels of a backjump before backtracking
+         * chronologically instead, 0 if disabled
+         */
+        unsigned int chronoThreshold;
+        /** The number of chronological backtracks performed */
+        uint64_t nbChronoBacktrack;
+        /**
+         * The literals kept on the stack during a backtrack, as they were
+         * implied at a remaining level
+         */
+        Array<Lit> keptLiterals;
 
         /** The number of literals removed from the initial problem */
         unsigned int nbLitRemoved;
@@ -845,6 +1739,82 @@ namespace saturnin {
         unsigned int nbReducePerformed;
         /** The number of clauses that were removed */
         uint64_t nbClauseRemoved;
+        /** Whether the learnt clauses are vivified after the reduce */
+        bool vivification;
+        /**
+         * The number of propagations allowed to the vivification, as a
+         * fraction of the propagations since the previous one
+         */
+        double vivifyEffort;
+        /** The number of propagations at the end of the last vivification */
+        uint64_t lastVivifyPropag;
+        /** The number of literals removed by the vivification */
+        uint64_t nbVivifiedLits;
+        /** Whether the clauses are subsumed before and during the search */
+        bool subsumption;
+        /** The number of literals that a subsumption may visit */
+        int64_t subsumeBudget;
+        /** The number of conflicts at which the next subsumption is done */
+        uint64_t nextSubsume;
+        /** The number of conflicts between two subsumptions */
+        uint64_t subsumeInterval;
+        /** The number of clauses removed by the subsumption */
+        uint64_t nbSubsumedClauses;
+        /** The number of clauses strengthened by the subsumption */
+        uint64_t nbStrengthenedClauses;
+        /** Whether the failed literals are probed before and during the search */
+        bool probing;
+        /** The number of propagations that a probing may do */
+        uint64_t probeBudget;
+        /** The number of conflicts at which the next probing is done */
+        uint64_t nextProbe;
+        /** The number of conflicts between two probings */
+        uint64_t probeInterval;
+        /** The variable from which the next probing starts */
+        Var nextProbeVar;
+        /** The number of failed literals found by the probing */
+        uint64_t nbFailedLiterals;
+        /** The number of literals proven as both polarities imply them */
+        uint64_t nbProbedUnits;
+        /** The number of equivalences found by the probing */
+        uint64_t nbProbedEquivalences;
+        /** The number of hyper-binary resolvents added by the probing */
+        uint64_t nbHyperBinaries;
+        /** Whether the transitive binary clauses are removed after the probing */
+        bool transitiveReduction;
+        /** The number of binary watchers that a transitive reduction may visit */
+        int64_t transitiveBudget;
+        /** The literal from which the next transitive reduction starts */
+        Lit nextTransitiveLit;
+        /** The number of transitive binary clauses removed */
+        uint64_t nbTransitiveBinaries;
+        /** Whether the learnt clauses are minimized with the binary clauses */
+        bool binaryMinimization;
+        /** The maximum size of a learnt clause minimized with the binary clauses */
+        unsigned int binaryMinimizationSize;
+        /** The maximum lbd of a learnt clause minimized with the binary clauses */
+        unsigned int binaryMinimizationLBD;
+        /** The number of literals removed by the recursive minimization */
+        uint64_t nbMinimizedLits;
+        /** The number of literals removed by the binary minimization */
+        uint64_t nbBinaryMinimizedLits;
+        /** Whether the reasons subsumed during the analysis are strengthened */
+        bool onTheFlySubsumption;
+        /** The reasons found subsumed by the last analysis */
+        Array<CRef> otfsReasons;
+        /** The literal to remove from each of those reasons */
+        Array<Lit> otfsPivots;
+        /**
+         * The subsumed reason whose resolvent was the learnt clause before
+         * its minimization, or CRef_Undef
+         */
+        CRef otfsAsserting;
+        /** The size of the learnt clause when otfsAsserting was found */
+        unsigned int otfsAssertingSize;
+        /** The number of reasons strengthened during the analysis */
+        uint64_t nbOnTheFlyStrengthened;
+        /** The number of learnt clauses replaced by a strengthened reason */
+        uint64_t nbOnTheFlyLearnt;
         
         /** 
          * The number of values taken for the average lbd over some last
@@ -866,6 +1836,10 @@ namespace saturnin {
 
         /** The current total number of restart performed */
         uint64_t restarts;
+        /** The total number of levels kept during the restarts */
+        uint64_t nbReusedLevels;
+        /** Whether the restarts keep the levels that would be rebuilt */
+        bool reuseTrail;
         /** The current total number of propagations made */
         uint64_t nbPropag;
         /** The current total number of conflict found */
@@ -889,8 +1863,15 @@ namespace saturnin {
         /** The factor applied to the reluctant suite */
         int factor;
 
-        /** The allocator used for the clauses generated by this solver */
-        ClauseAllocator allocator;
+        /** The arena holding the clauses generated by this solver */
+        ClauseArena arena;
+        /**
+         * The fraction of wasted words in the arena from which the clauses
+         * are relocated during a reduce
+         */
+        double garbageFraction;
+        /** The number of garbage collections performed */
+        unsigned int nbGarbageCollect;
 
         /** 
          * This array will map for each assignation level a value to indicate
@@ -911,12 +1892,6 @@ namespace saturnin {
          * value
          */
         Array<unsigned int> lbdValues;
-        
-        /**
-         * This array is used in the analyze method to mark which variables have
-         * already been seen
-         */
-        Array<bool> seen;
 
         /**
          * The mapping between the external variable names to the internal
@@ -930,6 +1905,24 @@ namespace saturnin {
         /** The variable value for the next variable that has not been mapped yet */
         unsigned int nextVarMap;
 
+        /**
+         * The clauses removed by the variable elimination, in the order of
+         * their removal. Each clause is stored as its literals, the first
+         * being the literal of the eliminated variable, followed by its size
+         */
+        Array<Lit> extensionStack;
+
+        /**
+         * The value of the variables, not mapped, once a solution has been
+         * extended to the eliminated variables
+         */
+        Array<wbool> model;
+
+        /**
+         * Compute model from the current assignation and the extension stack
+         */
+        void extendModel();
+
         /**
          * This array is used whenever we are looking up for pure literals:
          * variables that appear using only one phase: either l or ¬l
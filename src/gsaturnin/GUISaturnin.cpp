@@ -12,9 +12,7 @@
 gsaturnin::GUISaturnin::GUISaturnin(int argc, char ** argv) : launcher(argc, argv), propagations("Propagations"), nbClauses("Nb Clauses"), 
 conflicts("Conflicts"), assignLevel("Assign Level"), memory("Usage (Mb)")
 #ifdef PROFILE
-,profile_propagateMono("Monowatch propagation"),
-profile_propagateBin("Binary propagation"),
-profile_propagateWatched("Watched propagation"),
+,profile_propagate("Propagation"),
 profile_reduce("Reduce"),
 profile_analyze("Analyze"),
 profile_simplify("Simplify")
@@ -32,26 +30,19 @@ void gsaturnin::GUISaturnin::stop() {
 }
 
 
+#ifdef PROFILE
 float clause_repartition(void* data, int idx) {
     auto* solver = static_cast<saturnin::Solver*>(data);
-#ifndef PROFILE
-    return static_cast<float>(solver->getAllocator().getPool(idx).getSize());
-#else
     if (idx == 2) return static_cast<float>(solver->getNbBinaryClauses());
-    return static_cast<float>(solver->getAllocator().getClauseRepartition().get(idx));
-#endif /* PROFILE */
+    return static_cast<float>(solver->getArena().getClauseRepartition().get(idx));
 }
+#endif /* PROFILE */
 
 float lbd_repartition(void* data, int idx) {
     auto* solver = static_cast<saturnin::Solver*>(data);
     return static_cast<float>(solver->getLBDDistribution()[static_cast<unsigned int>(idx)]);
 }
 
-float memusage_clausePools(void* data, int idx) {
-    auto* solver = static_cast<saturnin::Solver*>(data);
-    return solver->getAllocator().getPool(idx).getMemoryFootprint()/(1024.f);
-}
-
 void gsaturnin::GUISaturnin::draw() {
     updateData();
     ImGui::SetNextWindowSize(ImVec2(442, 235), ImGuiSetCond_Always);
@@ -79,9 +70,7 @@ void gsaturnin::GUISaturnin::draw() {
     conflicts.draw();
     assignLevel.draw();
 #ifdef PROFILE
-    ImGui::PlotHistogram("Clause repartition", clause_repartition, static_cast<void*>(const_cast<saturnin::Solver*>(solver)), solver->getAllocator().getClauseRepartition().getSize());
-#else
-    ImGui::PlotHistogram("Clause repartition", clause_repartition, static_cast<void*>(const_cast<saturnin::Solver*>(solver)), solver->getAllocator().getNbPools());
+    ImGui::PlotHistogram("Clause repartition", clause_repartition, static_cast<void*>(const_cast<saturnin::Solver*>(solver)), solver->getArena().getClauseRepartition().getSize());
 #endif
     ImGui::PlotHistogram("LBD distribution", lbd_repartition, static_cast<void*>(const_cast<saturnin::Solver*>(solver)), solver->getLBDDistribution().getSize());
     ImGui::End();
@@ -90,16 +79,15 @@ void gsaturnin::GUISaturnin::draw() {
     ImGui::SetNextWindowPos(ImVec2(471, 17), ImGuiSetCond_Always);
     ImGui::Begin("Memory");
     memory.draw();
-    ImGui::PlotHistogram("Clauses (Kb)", memusage_clausePools, static_cast<void*>(const_cast<saturnin::Solver*>(solver)), solver->getAllocator().getNbPools());
+    ImGui::Text("Clause arena (Kb):  %12.1f", solver->getArena().getMemoryFootprint() / 1024.f);
+    ImGui::Text("Wasted (Kb):        %12.1f", solver->getArena().getWasted() * sizeof(uint32_t) / 1024.f);
     ImGui::End();
 
 #ifdef PROFILE
     ImGui::SetNextWindowSize(ImVec2(442, 249), ImGuiSetCond_Always);
     ImGui::SetNextWindowPos(ImVec2(471, 269), ImGuiSetCond_Always);
     ImGui::Begin("Profile");
-    profile_propagateMono.draw();
-    profile_propagateBin.draw();
-    profile_propagateWatched.draw();
+    profile_propagate.draw();
     profile_reduce.draw();
     profile_analyze.draw();
     //profile_simplify.draw();
@@ -156,15 +144,11 @@ void gsaturnin::GUISaturnin::updateData() {
         assignLevel.push(static_cast<float>(solver->getAssignationLevel()));
         memory.push(static_cast<float>(solver->getMemoryFootprint() / (1024.0*1024.0)));
 #ifdef PROFILE
-        auto duration = solver->__profile_propagateMono
-                      + solver->__profile_propagateBin 
-                      + solver->__profile_propagateWatched 
+        auto duration = solver->__profile_propagate
                       + solver->__profile_reduce 
                       + solver->__profile_analyze;
         //duration = 100;
-        profile_propagateMono.push(static_cast<float>(solver->__profile_propagateMono*100.0 / duration));
-        profile_propagateBin.push(static_cast<float>(solver->__profile_propagateBin*100.0 / duration));
-        profile_propagateWatched.push(static_cast<float>(solver->__profile_propagateWatched*100.0 / duration));
+        profile_propagate.push(static_cast<float>(solver->__profile_propagate*100.0 / duration));
         profile_reduce.push(static_cast<float>(solver->__profile_reduce*100.0 / duration));
         profile_analyze.push(static_cast<float>(solver->__profile_analyze*100.0 / duration));
         profile_simplify.push(static_cast<float>(solver->__profile_simplify*100.0 / duration));
@@ -32,9 +32,7 @@ namespace gsaturnin {
         ValueEvolution<HistoryLenght> assignLevel;
         ValueEvolution<HistoryLenght> memory;
 #ifdef PROFILE
-        ValueEvolution<HistoryLenght> profile_propagateMono;
-        ValueEvolution<HistoryLenght> profile_propagateBin;
-        ValueEvolution<HistoryLenght> profile_propagateWatched;
+        ValueEvolution<HistoryLenght> profile_propagate;
         ValueEvolution<HistoryLenght> profile_reduce;
         ValueEvolution<HistoryLenght> profile_analyze;
         ValueEvolution<HistoryLenght> profile_simplify;
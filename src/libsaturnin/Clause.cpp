@@ -8,6 +8,8 @@ Clause::Clause(const Lit* const literals, unsigned int sz, unsigned int l) :
         size(sz), compact(), index(0), data(){
     compact.lbd = l;
     compact.toRemove = false;
+    compact.vivified = false;
+    compact.relocated = false;
     compact.attached = true;
     compact.freezeCounter = 0;
     for(unsigned int i = 0; i<sz; i++){
@@ -0,0 +1,155 @@
+#include "saturnin/ClauseArena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <utility>
+#include "saturnin/Assert.h"
+#include "saturnin/Clause.h"
+#include "saturnin/Logger.h"
+
+using namespace saturnin;
+
+static_assert(sizeof (Clause) % sizeof (uint32_t) == 0, "A clause must be made of 32 bits words");
+
+/**
+ * Stop the program when the arena can't grow. A clause that couldn't be
+ * stored would silently break the propagation
+ * @param reason the reason why the arena can't grow
+ */
+static void arenaExhausted(const char* reason) {
+    fprintf(Logger::getStdErrLogger().getOutput(), "c clause arena: %s\n", reason);
+    abort();
+}
+
+ClauseArena::ClauseArena(unsigned int cap) : memory(nullptr), size(0), capacity(cap), wasted(0), nbClauses(0)
+#ifdef PROFILE
+, clauseRepartition(36)
+#endif /* PROFILE */
+{
+    if (capacity < getNbWords(3)) {
+        capacity = getNbWords(3);
+    }
+    memory = (uint32_t*) malloc((size_t) capacity * sizeof (uint32_t));
+    if (memory == nullptr) {
+        arenaExhausted("out of memory");
+    }
+}
+
+ClauseArena::~ClauseArena() {
+    free(memory);
+    memory = nullptr;
+}
+
+CRef ClauseArena::createClause(const Lit * const lits, unsigned int sz, unsigned int lbd) {
+    ASSERT(lits != nullptr);
+    ASSERT(sz > 1);
+#ifdef PROFILE
+    while (clauseRepartition.getSize() <= sz) {
+        clauseRepartition.push(0U);
+    }
+    clauseRepartition[sz]++;
+#endif /* PROFILE */
+    CRef ref = allocate(getNbWords(sz));
+    nbClauses++;
+    new (memory + ref) Clause(lits, sz, lbd);
+    ASSERT((*this)[ref].getSize() == sz);
+    return ref;
+}
+
+CRef ClauseArena::allocate(unsigned int nbWords) {
+    //the two highest bits of a reference are used by the watchers
+    if (size > watcher_t::refMask) {
+        arenaExhausted("more than 2^30 words of clauses can't be referenced by the watchers");
+    }
+    if (size + nbWords > capacity) {
+        unsigned int newCapacity = capacity;
+        while (size + nbWords > newCapacity) {
+            unsigned int grown = (unsigned int) (SATURNIN_CLAUSEARENA_UPDATE_FACTOR * newCapacity);
+            //make sure we progress even for an empty arena
+            newCapacity = grown > newCapacity + nbWords ? grown : newCapacity + nbWords;
+        }
+        uint32_t* tmp = (uint32_t*) realloc(memory, (size_t) newCapacity * sizeof (uint32_t));
+        if (tmp == nullptr) {
+            arenaExhausted("out of memory");
+        }
+        memory = tmp;
+        capacity = newCapacity;
+    }
+    CRef ref = size;
+    size += nbWords;
+    return ref;
+}
+
+CRef ClauseArena::createClause(const Array<Lit>& lits, unsigned int lbd) {
+    return createClause((const Lit*) lits, lits.getSize(), lbd);
+}
+
+void ClauseArena::releaseClause(CRef& c) {
+    ASSERT(c != CRef_Undef);
+    Clause& cl = (*this)[c];
+    ASSERT(cl.getSize() > 1);
+#ifdef PROFILE
+    ASSERT(clauseRepartition[cl.getSize()] > 0);
+    clauseRepartition[cl.getSize()]--;
+#endif /* PROFILE */
+    wasted += getNbWords(cl.getSize());
+    ASSERT(nbClauses > 0);
+    nbClauses--;
+    cl.~Clause();
+    c = CRef_Undef;
+}
+
+void ClauseArena::removeLit(CRef c, unsigned int pos) {
+    ASSERT(c != CRef_Undef);
+    Clause& cl = (*this)[c];
+    ASSERT(pos < cl.getSize());
+    ASSERT(cl.getSize() > 2);
+#ifdef PROFILE
+    ASSERT(clauseRepartition[cl.getSize()] > 0);
+    clauseRepartition[cl.getSize()]--;
+    clauseRepartition[cl.getSize() - 1]++;
+#endif /* PROFILE */
+    wasted += getNbWords(cl.getSize()) - getNbWords(cl.getSize() - 1);
+    cl.removeLit(pos);
+}
+
+void ClauseArena::relocate(CRef& c, ClauseArena& to) {
+    ASSERT(c != CRef_Undef);
+    Clause& cl = (*this)[c];
+    if (cl.isRelocated()) {
+        c = cl.getRelocation();
+        return;
+    }
+    unsigned int nbWords = getNbWords(cl.getSize());
+    CRef ref = to.allocate(nbWords);
+    memcpy(to.memory + ref, memory + c, nbWords * sizeof (uint32_t));
+    to.nbClauses++;
+#ifdef PROFILE
+    while (to.clauseRepartition.getSize() <= cl.getSize()) {
+        to.clauseRepartition.push(0U);
+    }
+    to.clauseRepartition[cl.getSize()]++;
+#endif /* PROFILE */
+    cl.relocate(ref);
+    c = ref;
+}
+
+void ClauseArena::moveTo(ClauseArena& to) {
+    free(to.memory);
+    to.memory = memory;
+    to.size = size;
+    to.capacity = capacity;
+    to.wasted = wasted;
+    to.nbClauses = nbClauses;
+#ifdef PROFILE
+    to.clauseRepartition = std::move(clauseRepartition);
+    clauseRepartition = Array<unsigned int>(36);
+#endif /* PROFILE */
+    memory = nullptr;
+    size = 0;
+    capacity = 0;
+    wasted = 0;
+    nbClauses = 0;
+}
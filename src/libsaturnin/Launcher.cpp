@@ -33,6 +33,30 @@ saturnin::Solver* solverToStop = nullptr;
 uint64_t totalCycles = 0;
 #endif /* PROFILE */
 
+#ifdef SATURNIN_PARALLEL
+/**
+ * Read the name of a branching heuristic
+ * @param name the name, followed by the end of the string or a comma
+ * @param h will contain the heuristic named by @a name
+ * @return the number of characters of the name, 0 if it is unknown
+ */
+static size_t parseBranchingHeuristic(const char* name, saturnin::Solver::BranchingHeuristic& h) {
+    if (strncmp(name, "vsids", (size_t)5) == 0) {
+        h = saturnin::Solver::BranchingHeuristic::VSIDS;
+        return 5;
+    }
+    if (strncmp(name, "vmtf", (size_t)4) == 0) {
+        h = saturnin::Solver::BranchingHeuristic::VMTF;
+        return 4;
+    }
+    if (strncmp(name, "lrb", (size_t)3) == 0) {
+        h = saturnin::Solver::BranchingHeuristic::LRB;
+        return 3;
+    }
+    return 0;
+}
+#endif /* SATURNIN_PARALLEL */
+
 #if defined (WIN32) || defined (_MSC_VER)
 
 BOOL WINAPI winSigStopLauncher(DWORD dwCtrlType) {
@@ -87,43 +111,58 @@ void saturnin::Launcher::printMemoryValue(FILE * fi, size_t mem) const {
     fprintf(fi, "%14.3f %cb", mem / f, prefix[i]);
 }
 
-void saturnin::Launcher::simplify(saturnin::Solver& s, saturnin::CNFReader& reader) {
+unsigned int saturnin::Launcher::simplify(saturnin::Solver& s, saturnin::CNFReader& reader, bool covered, unsigned int& nbSubstituted, unsigned int& nbBlocked) {
+    nbSubstituted = 0;
+    nbBlocked = 0;
     Simplifier simp(reader.getNbVar(), reader.getNbClauses());
-    for (unsigned int i = 0; i<reader.getNbClauses(); i++) {
-        simp.addClause((const Lit*)reader.getClause(i), reader.getClause(i).getSize());
-    }
+    simp.addClauses(reader.getClauses());
     simp.revival(reader.getAverageLength() + 1);
-    //add the proven literals
+    simp.probe();
+    if (simp.getState() == wFalse) {
+        //the proven literals may be inconsistent, let the solver find it
+        s.addClauses(reader.getClauses());
+        return 0;
+    }
+    //the presumed variables must keep their clauses
+    const saturnin::Array<saturnin::Lit>& pres = reader.getPresumptions();
+    for (unsigned int i = 0; i < pres.getSize(); i++) {
+        simp.freeze(saturnin::VariablesManager::getVar(pres.get(i)));
+    }
+    nbSubstituted = simp.substituteEquivalences();
+    nbBlocked = simp.eliminateBlockedClauses(covered);
+    unsigned int nbEliminated = simp.eliminateVariables();
+    if (simp.getState() == wFalse) {
+        //the instance is unsatisfiable, the reader clauses are enough to prove it
+        s.addClauses(reader.getClauses());
+        return nbEliminated;
+    }
+    //add the proven literals and the remaining clauses, the removed ones are
+    //empty
     const saturnin::Array<saturnin::Lit>& provenLits = simp.getProvenLit();
+    const saturnin::Array<saturnin::Array<saturnin::Lit> >& clauses = simp.getClauses();
+    saturnin::Array<saturnin::Array<saturnin::Lit> > batch(provenLits.getSize() + clauses.getSize());
     for (unsigned int i = 0; i < provenLits.getSize(); i++) {
-        saturnin::Lit l = provenLits.get(i);
-        ASSERT(l != saturnin::lit_Undef);
-        saturnin::Array<saturnin::Lit> cl(1U);
-        cl.push(l);
-        s.addClause(cl);
+        ASSERT(provenLits.get(i) != saturnin::lit_Undef);
+        batch.push(saturnin::Array<saturnin::Lit>(1U));
+        batch[batch.getSize() - 1].push(provenLits.get(i));
     }
-    //Add the binary clauses
-    for (unsigned int l = 0; l < reader.getNbVar() * 2; l++) {
-        //either the clause is SAT and the clause doesn't need to be added
-        //either the clause should be unary and has been already propagated
-        if (s.getVarValue(saturnin::VariablesManager::getVar(l)) != wUnknown) continue;
-        const saturnin::Array<saturnin::Lit>& binClauses = simp.getBinaryWith(l);
-        for (unsigned int j = 0; j < binClauses.getSize(); j++) {
-            saturnin::Lit tmp = binClauses.get(j);
-            if (tmp < l && s.getVarValue(saturnin::VariablesManager::getVar(tmp)) == wUnknown) {
-                saturnin::Array<saturnin::Lit> cl(2U);
-                cl.push(l);
-                cl.push(tmp);
-                s.addClause(cl);
+    for (unsigned int i = 0; i < clauses.getSize(); i++) {
+        const saturnin::Array<saturnin::Lit>& c = clauses.get(i);
+        if (c.getSize() > 0) {
+            batch.push(saturnin::Array<saturnin::Lit>(c.getSize()));
+            saturnin::Array<saturnin::Lit>& copy = batch[batch.getSize() - 1];
+            for (unsigned int j = 0; j < c.getSize(); j++) {
+                copy.push(c.get(j));
             }
         }
     }
-
-    //add the rest of the clauses
-    const saturnin::Array<saturnin::Clause*>& clauses = simp.getInitialClauses();
-    for (unsigned int i = 0; i < clauses.getSize(); i++) {
-        s.addClause(clauses.get(i)->lits(), clauses.get(i)->getSize());
+    s.addClauses(batch);
+    //the removed clauses are needed to extend the model
+    const saturnin::Array<saturnin::Lit>& ext = simp.getExtensionStack();
+    for (unsigned int i = 0; i < ext.getSize(); i += ext.get(i) + 1) {
+        s.addEliminatedClause((const saturnin::Lit*) ext + i + 1, ext.get(i));
     }
+    return nbEliminated;
 }
 
 saturnin::Launcher::Launcher(int argc, char ** argv) : clean_exit(false), w(), readMem(0) {
@@ -138,8 +177,25 @@ saturnin::Launcher::Launcher(int argc, char ** argv) : clean_exit(false), w(), r
 
 #ifdef SATURNIN_PARALLEL
     unsigned int nbThreads = 1;
+    //the heuristics given to the threads, in turn
+    Array<Solver::BranchingHeuristic> heuristics(4);
 #else
     bool optSimplify = false;
+    bool covered = false;
+    unsigned int chronoThreshold = 0;
+    bool reuseTrail = true;
+    Solver::BranchingHeuristic heuristic = Solver::BranchingHeuristic::VSIDS;
+    bool targetPhase = false;
+    bool rephase = false;
+    bool vivify = true;
+    bool subsume = true;
+    bool probe = true;
+    bool transitive = true;
+    bool binMinimize = true;
+    bool otfs = true;
+    unsigned int nbEliminated = 0;
+    unsigned int nbSubstituted = 0;
+    unsigned int nbBlocked = 0;
 #endif /* SATURNIN_PARALLEL */
     int timeLim = -1;
 #ifdef SATURNIN_DB
@@ -160,10 +216,64 @@ saturnin::Launcher::Launcher(int argc, char ** argv) : clean_exit(false), w(), r
                 nbThreads = 1;
             }
         }
+        else if (strncmp(argv[i], "-branching=", (size_t)11) == 0) {
+            const char* name = argv[i] + 11;
+            Solver::BranchingHeuristic h;
+            size_t len = parseBranchingHeuristic(name, h);
+            while (len > 0) {
+                heuristics.push(h);
+                name += len;
+                len = *name == ',' ? parseBranchingHeuristic(name + 1, h) : 0;
+                name++;
+            }
+        }
 #else
         else if (strncmp(argv[i], "-simplify", (size_t)9) == 0) {
             optSimplify = true;
         }
+        else if (strncmp(argv[i], "-covered", (size_t)8) == 0) {
+            covered = true;
+        }
+        else if (strncmp(argv[i], "-vmtf", (size_t)5) == 0) {
+            heuristic = Solver::BranchingHeuristic::VMTF;
+        }
+        else if (strncmp(argv[i], "-lrb", (size_t)4) == 0) {
+            heuristic = Solver::BranchingHeuristic::LRB;
+        }
+        else if (strncmp(argv[i], "-target-phase", (size_t)13) == 0) {
+            targetPhase = true;
+        }
+        else if (strncmp(argv[i], "-rephase", (size_t)8) == 0) {
+            rephase = true;
+        }
+        else if (strncmp(argv[i], "-no-vivify", (size_t)10) == 0) {
+            vivify = false;
+        }
+        else if (strncmp(argv[i], "-no-subsume", (size_t)11) == 0) {
+            subsume = false;
+        }
+        else if (strncmp(argv[i], "-no-probe", (size_t)9) == 0) {
+            probe = false;
+        }
+        else if (strncmp(argv[i], "-no-transitive", (size_t)14) == 0) {
+            transitive = false;
+        }
+        else if (strncmp(argv[i], "-no-bin-minimize", (size_t)16) == 0) {
+            binMinimize = false;
+        }
+        else if (strncmp(argv[i], "-no-otfs", (size_t)8) == 0) {
+            otfs = false;
+        }
+        else if (strncmp(argv[i], "-no-reuse-trail", (size_t)15) == 0) {
+            reuseTrail = false;
+        }
+        else if (strncmp(argv[i], "-chrono=", (size_t)8) == 0) {
+            char* out = nullptr;
+            chronoThreshold = strtoul(argv[i] + 8, &out, 10);
+            if (out == (argv[i] + 8)) {
+                chronoThreshold = 0;
+            }
+        }
 #endif /* SATURNIN_PARALLEL */
 #ifdef SATURNIN_DB 
         else if (strncmp(argv[i], "-d=", (size_t)3) == 0) {
@@ -203,6 +313,9 @@ saturnin::Launcher::Launcher(int argc, char ** argv) : clean_exit(false), w(), r
         , dbFileName
 #endif /* SATURNIN_DB */
     );
+    for (unsigned int i = 0; i < nbThreads && heuristics.getSize() > 0; i++) {
+        solver->getSolver(i).setBranchingHeuristic(heuristics[i % heuristics.getSize()]);
+    }
 #else
     solver = new Solver(reader->getNbVar(), reader->getNbClauses()
 #ifdef SATURNIN_DB
@@ -210,13 +323,22 @@ saturnin::Launcher::Launcher(int argc, char ** argv) : clean_exit(false), w(), r
 #endif /* SATURNIN_DB */
     );
     solverToStop = solver;
+    solver->setChronologicalBacktrack(chronoThreshold);
+    solver->setReuseTrail(reuseTrail);
+    solver->setBranchingHeuristic(heuristic);
+    solver->setTargetPhase(targetPhase);
+    solver->setRephase(rephase);
+    solver->setVivification(vivify);
+    solver->setSubsumption(subsume);
+    solver->setProbing(probe);
+    solver->setTransitiveReduction(transitive);
+    solver->setBinaryMinimization(binMinimize);
+    solver->setOnTheFlySubsumption(otfs);
     if (optSimplify) {
-        simplify(*solver, *reader);
+        nbEliminated = simplify(*solver, *reader, covered, nbSubstituted, nbBlocked);
     }
     else {
-        for (unsigned int i = 0; i<reader->getNbClauses(); i++) {
-            solver->addClause(reader->getClause(i));
-        }
+        solver->addClauses(reader->getClauses());
     }
 #endif /* SATURNIN_PARALLEL */
     
@@ -270,6 +392,9 @@ saturnin::Launcher::Launcher(int argc, char ** argv) : clean_exit(false), w(), r
     solver->simplify();
     printf("c\t\tNb clauses simplified: %12d\n", simplifiedNb - solver->getNbClauses());
     printf("c\t\tNb lit removed:        %12d\n", solver->getNbLitRemoved());
+    printf("c\t\tNb vars eliminated:    %12d\n", nbEliminated);
+    printf("c\t\tNb vars substituted:   %12d\n", nbSubstituted);
+    printf("c\t\tNb clauses blocked:    %12d\n", nbBlocked);
 #endif
 }
 
@@ -339,21 +464,51 @@ double saturnin::Launcher::getEllapsedTime() const {
 void saturnin::Launcher::printStats(Solver & s) const {
     printf("c Time:              %14.2f sec\n", w.getTimeEllapsed());
     if (s.getVerbosity() > 0) {
+        const ClauseArena& arena = s.getArena();
+        printf("c Clause arena:      %14u clauses\n", arena.getNbClauses());
+        printf("c Arena words:       %14u/%-14u (%.3f, wasted: %u)\n",
+            arena.getSize(), arena.getCapacity(),
+            (1.0 * arena.getSize()) / arena.getCapacity(), arena.getWasted());
+#ifdef PROFILE
         printf("c Clause distribution:\n");
-        const ClauseAllocator& alloc = s.getAllocator();
-        for (unsigned int i = 0; i < alloc.getNbPools(); i++) {
-            printf("c %4d-%4d: %14d/%-14d (%.3f)\n", (i + 1) * 2, ((i + 1) * 2) + 1,
-                alloc.getPool(i).getSize(),
-                alloc.getPool(i).getCapacity(),
-                (1.0 * alloc.getPool(i).getSize()) / alloc.getPool(i).getCapacity());
+        const Array<unsigned int>& repartition = arena.getClauseRepartition();
+        for (unsigned int i = 0; i < repartition.getSize(); i++) {
+            if (repartition.get(i) > 0) {
+                printf("c %9d: %14u\n", i, repartition.get(i));
+            }
         }
+#endif /* PROFILE */
     }
 
     printf("c Nb propagations:   %14" PRIu64 " (%.2f propagations/second)\n",
         s.getNbPropagation(), s.getNbPropagation() / w.getTimeEllapsed());
     printf("c Nb conflicts:      %14" PRIu64 " (%.2f conflicts/second)\n",
         s.getNbConflict(), s.getNbConflict() / w.getTimeEllapsed());
+    printf("c Nb decisions:      %14" PRIu64 " (%.2f decisions/second)\n",
+        s.getNbDecisions(), s.getNbDecisions() / w.getTimeEllapsed());
     printf("c Nb restarts:       %14" PRIu64 "\n", s.getNbRestarts());
+    printf("c Levels reused:     %14" PRIu64 " (%.2f levels/restart)\n",
+        s.getNbReusedLevels(), s.getNbRestarts() > 0 ? (1.0 * s.getNbReusedLevels()) / s.getNbRestarts() : 0.0);
+    if (s.getChronologicalBacktrack() != 0) {
+        printf("c Nb chrono backtrack:%13" PRIu64 "\n", s.getNbChronologicalBacktrack());
+    }
+    printf("c Nb rephases:       %14" PRIu64 "\n", s.getNbRephases());
+    printf("c Vivified literals: %14" PRIu64 " (%.2f literals/reduce)\n",
+        s.getNbVivifiedLiterals(), s.getNbReduce() > 0 ? (1.0 * s.getNbVivifiedLiterals()) / s.getNbReduce() : 0.0);
+    printf("c Subsumed clauses:  %14" PRIu64 "\n", s.getNbSubsumedClauses());
+    printf("c Strengthened:      %14" PRIu64 "\n", s.getNbStrengthenedClauses());
+    printf("c Failed literals:   %14" PRIu64 " (implied units: %" PRIu64 ", equivalences: %" PRIu64 ")\n",
+        s.getNbFailedLiterals(), s.getNbProbedUnits(), s.getNbProbedEquivalences());
+    printf("c Binary clauses:    %14u (hyper-binary: %" PRIu64 ", transitive removed: %" PRIu64 ")\n",
+        s.getNbBinaryClauses(), s.getNbHyperBinaries(), s.getNbTransitiveBinaries());
+    double nbConflicts = s.getNbConflict() > 0 ? (double) s.getNbConflict() : 1.0;
+    printf("c Minimized literals:%14" PRIu64 " (%.2f literals/conflict)\n",
+        s.getNbMinimizedLits(), s.getNbMinimizedLits() / nbConflicts);
+    printf("c Binary minimized:  %14" PRIu64 " (%.2f literals/conflict)\n",
+        s.getNbBinaryMinimizedLits(), s.getNbBinaryMinimizedLits() / nbConflicts);
+    printf("c OTF strengthened:  %14" PRIu64 " (%.2f per 1000 conflicts, learnt replaced: %" PRIu64 ")\n",
+        s.getNbOnTheFlyStrengthened(), 1000 * s.getNbOnTheFlyStrengthened() / nbConflicts,
+        s.getNbOnTheFlyLearnt());
     printf("c Nb reduce:         %14d\n", s.getNbReduce());
     printf("c Clauses removed:   %14" PRIu64 " (initial: %" PRIu64 ", learnt: %" PRIu64 ")\n",
         s.getNbClausesRemoved() + s.getNbInitialClausesRemoved(),
@@ -370,12 +525,21 @@ void saturnin::Launcher::printStats(Solver & s) const {
 #ifdef PROFILE
     printf("c Profile :\n");
     long double ldtotal = totalCycles / 100.0;
-    printf("c   propagate watch: %5.2LF%% (%22" PRIu64 ")\n", s.__profile_propagateWatched / ldtotal, s.__profile_propagateWatched);
-    printf("c   propagate bin  : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_propagateBin / ldtotal, s.__profile_propagateBin);
-    printf("c   propagate mono : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_propagateMono / ldtotal, s.__profile_propagateMono);
+    printf("c   propagate      : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_propagate / ldtotal, s.__profile_propagate);
     printf("c   analyze        : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_analyze / ldtotal, s.__profile_analyze);
     printf("c   reduce         : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_reduce / ldtotal, s.__profile_reduce);
     printf("c   simplify       : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_simplify / ldtotal, s.__profile_simplify);
+    printf("c   decide         : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_decide / ldtotal, s.__profile_decide);
+    printf("c   subsume        : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_subsume / ldtotal, s.__profile_subsume);
+    printf("c   probe          : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_probe / ldtotal, s.__profile_probe);
+    printf("c Watchers visited :\n");
+    uint64_t nbVisits = s.__profile_visits[watcher_t::wkLong] + s.__profile_visits[watcher_t::wkBinary]
+            + s.__profile_visits[watcher_t::wkFrozen] + s.__profile_visits[watcher_t::wkTernary];
+    long double ldvisits = (nbVisits > 0 ? nbVisits : 1) / 100.0;
+    printf("c   binary         : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_visits[watcher_t::wkBinary] / ldvisits, s.__profile_visits[watcher_t::wkBinary]);
+    printf("c   ternary        : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_visits[watcher_t::wkTernary] / ldvisits, s.__profile_visits[watcher_t::wkTernary]);
+    printf("c   long           : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_visits[watcher_t::wkLong] / ldvisits, s.__profile_visits[watcher_t::wkLong]);
+    printf("c   frozen         : %5.2LF%% (%22" PRIu64 ")\n", s.__profile_visits[watcher_t::wkFrozen] / ldvisits, s.__profile_visits[watcher_t::wkFrozen]);
 #endif
 }
 
@@ -429,6 +593,28 @@ void saturnin::Launcher::printHelp(char * programName) const {
 #endif /* WIN32 */
 #ifdef SATURNIN_PARALLEL
     printf("c \t-t=X         the number of threads to be used in the search\n");
+    printf("c \t-branching=H1,H2,...  the branching heuristic of each thread,\n");
+    printf("c \t             given in turn: vsids, vmtf or lrb\n");
+#else
+    printf("c \t-simplify    simplify the instance (revival, equivalent literals,\n");
+    printf("c \t             blocked clauses, variable elimination) before the search\n");
+    printf("c \t-covered     with -simplify, remove the covered clauses as well\n");
+    printf("c \t-chrono=X    backtrack chronologically when the backjump\n");
+    printf("c \t             would remove more than X levels (0: never)\n");
+    printf("c \t-no-reuse-trail  backtrack to level 0 at each restart\n");
+    printf("c \t-vmtf        pick the decisions with VMTF instead of VSIDS\n");
+    printf("c \t-lrb         pick the decisions with LRB instead of VSIDS\n");
+    printf("c \t-target-phase  decide with the phases of the longest trail\n");
+    printf("c \t             without conflict\n");
+    printf("c \t-rephase     periodically reset the phases\n");
+    printf("c \t-no-vivify   don't shorten the learnt clauses after each reduce\n");
+    printf("c \t-no-subsume  don't remove the subsumed clauses\n");
+    printf("c \t-no-probe    don't probe the failed literals\n");
+    printf("c \t-no-transitive  don't remove the transitive binary clauses\n");
+    printf("c \t-no-bin-minimize  don't minimize the learnt clauses with the\n");
+    printf("c \t             binary clauses\n");
+    printf("c \t-no-otfs     don't strengthen the reasons subsumed during the\n");
+    printf("c \t             conflict analysis\n");
 #endif /* SATURNIN_PARALLEL */
 #ifdef SATURNIN_DB
     printf("c \t-d=fileName  the file to be used to store the database\n");
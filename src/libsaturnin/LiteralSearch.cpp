@@ -0,0 +1,50 @@
+#include "saturnin/LiteralSearch.h"
+
+#ifdef SATURNIN_SIMD_AVX2
+#include <immintrin.h>
+#endif /* SATURNIN_SIMD_AVX2 */
+
+using namespace saturnin;
+
+const bool LiteralSearch::useAVX2 = LiteralSearch::isAVX2Supported();
+
+bool LiteralSearch::isAVX2Supported() {
+#ifdef SATURNIN_SIMD_AVX2
+    //needed as this may be called before the constructors are run
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif /* SATURNIN_SIMD_AVX2 */
+}
+
+#ifdef SATURNIN_SIMD_AVX2
+
+__attribute__((target("avx2")))
+unsigned int LiteralSearch::findNonFalseAVX2(const Lit* lits, unsigned int from, unsigned int sz, const wbool* values) {
+    //a literal is smaller than 2^31, therefore it can be used as a signed index
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i falseValue = _mm256_set1_epi32(wFalse);
+    unsigned int pos = from;
+    for (; pos + 8 <= sz; pos += 8) {
+        __m256i indexes = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (lits + pos));
+        //each gather reads 4 bytes starting at the value of the literal,
+        //only the first one is kept
+        __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*> (values), indexes, 1);
+        v = _mm256_and_si256(v, byteMask);
+        unsigned int isFalse = static_cast<unsigned int> (
+                _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, falseValue))));
+        if (isFalse != 0xFF) {
+            return pos + static_cast<unsigned int> (__builtin_ctz(~isFalse));
+        }
+    }
+    return findNonFalseScalar(lits, pos, sz, values);
+}
+
+#else
+
+unsigned int LiteralSearch::findNonFalseAVX2(const Lit* lits, unsigned int from, unsigned int sz, const wbool* values) {
+    return findNonFalseScalar(lits, from, sz, values);
+}
+
+#endif /* SATURNIN_SIMD_AVX2 */
@@ -76,6 +76,12 @@ Solver& ParallelSolver::getWinningSolver(){
     }
 }
 
+Solver& ParallelSolver::getSolver(unsigned int i) {
+    ASSERT(i < nbThreads);
+    ASSERT(solvers[i] != nullptr);
+    return *(solvers[i]);
+}
+
 size_t ParallelSolver::getMemoryFootprint() const {
     size_t sz = 0;
     sz += firstNonIncludedClause.getMemoryFootprint();
@@ -134,9 +140,7 @@ dbFileName
     for (unsigned int i = 0; i < nbThreads; i++) {
         Solver* cur = solvers[i];
         threadPool[i] = std::thread([cur, &r]() {
-            for (unsigned int j = 0; j < r.getNbClauses() && cur->getState() == wUnknown; j++) {
-                cur->addClause(r.getClause(j));
-            }
+            cur->addClauses(r.getClauses());
         });
     }
     for (unsigned int i = 0; i < nbThreads; i++) {
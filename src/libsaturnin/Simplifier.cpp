@@ -1,10 +1,15 @@
 #include "saturnin/Simplifier.h"
+#include <limits>
 #include "saturnin/Assert.h"
 #include "saturnin/Clause.h"
 
 using namespace saturnin;
 
-Simplifier::Simplifier(unsigned int nbVar, unsigned int nbClauses) : s(nbVar, nbClauses), nbClausesReduced(0U) {
+Simplifier::Simplifier(unsigned int nbVar, unsigned int nbClauses) : s(nbVar, nbClauses), nbClausesReduced(0U),
+elimClauses(nbClauses), occurs(nbVar * 2), nbOccurs(nbVar * 2), extensionStack(nbVar), frozen(nbVar),
+eliminated(nbVar), elimQueue(nbVar, ElimComp(*this)), litStamps(nbVar * 2), stamp(0), occurrencesBuilt(false), nbEliminatedVars(0), nbSubstitutedVars(0),
+nbBlockedClauses(0), nbCoveredClauses(0), maxResolventSize(20), maxOccurrences(100), elimBudget(100000000),
+blockedBudget(100000000), maxCoveredSize(50) {
 
 }
 
@@ -13,10 +18,11 @@ Simplifier::~Simplifier() {
 
 void Simplifier::revival(unsigned int min) {
     for (unsigned int i = 0; s.state == wUnknown && i < s.clauses.getSize(); i++) {
-        Clause* c = s.clauses.get(i);
-        s.stopWatchClause(c->getLit(0), c);
-        s.stopWatchClause(c->getLit(1), c);
+        CRef ref = s.clauses.get(i);
+        Clause* c = &s.arena[ref];
         if (c->getSize() >= min) {
+            //the shorter clauses stay watched to propagate the probes
+            s.detachClause(ref);
             bool stop = false;
             bool removeClause = false;
             Array<Lit> simplified;
@@ -24,7 +30,7 @@ void Simplifier::revival(unsigned int min) {
                 Lit l = c->getLit(j);
                 Var v = VariablesManager::getVar(l);
                 if (s.assign[v] != wUnknown) {
-                    if (s.varLevel[v] == 0) {
+                    if (s.varData[v].level == 0) {
                         if (s.assign[v] == (VariablesManager::getLitSign(l) ?
                                 wTrue : wFalse)) {
                             //c can be removed
@@ -51,8 +57,9 @@ void Simplifier::revival(unsigned int min) {
                     s.enqueue(VariablesManager::oppositeLit(l));
                     Lit* conflict = s.propagate();
                     if (conflict != nullptr) {
-                        //simplified subsumes c
+                        //simplified, with l, subsumes c
                         stop = true;
+                        simplified.push(l);
                         //generate the learnt clause. If it is smaller than
                         //simplified, we can use the learnt instead of simplified
                         Array<Lit> learnt(c->getSize());
@@ -72,6 +79,7 @@ void Simplifier::revival(unsigned int min) {
             ASSERT_EQUAL(0U, s.assignLevel);
             if (!removeClause && simplified.getSize() < c->getSize()) {
                 nbClausesReduced++;
+                //c is not valid anymore once the arena may have moved
                 unsigned int clSz = s.clauses.getSize();
                 bool added = simplified.getSize() > 0 &&
                         s.addClause((Lit*) simplified,
@@ -84,15 +92,556 @@ void Simplifier::revival(unsigned int min) {
                     i--;
                 }
                 s.clauses.pop();
-                s.allocator.releaseClause(c);
+                s.arena.releaseClause(ref);
             } else if (removeClause) {
                 s.clauses[i] = s.clauses.getLast();
                 s.clauses.pop();
                 i--;
-                s.allocator.releaseClause(c);
+                s.arena.releaseClause(ref);
             } else {
-                s.addWatchedClause(c);
+                s.addWatchedClause(ref);
+            }
+        }
+    }
+}
+
+wbool Simplifier::probe() {
+    ASSERT(!occurrencesBuilt);
+    if (s.state != wUnknown) {
+        return s.state;
+    }
+    return s.probe();
+}
+
+void Simplifier::freeze(Var v) {
+    while (frozen.getSize() <= v) {
+        frozen.push(false);
+    }
+    frozen[v] = true;
+}
+
+unsigned int Simplifier::eliminateVariables() {
+    buildOccurrences();
+    if (s.state != wUnknown) {
+        return 0;
+    }
+    for (Var v = 0; v < s.nbVar; v++) {
+        touch(v);
+    }
+    while (elimQueue.getSize() > 0 && elimBudget > 0) {
+        Var v = elimQueue.removeMin();
+        if (eliminate(v)) {
+            nbEliminatedVars++;
+        }
+    }
+    return nbEliminatedVars;
+}
+
+unsigned int Simplifier::eliminateBlockedClauses(bool covered) {
+    buildOccurrences();
+    if (s.state != wUnknown) {
+        return 0;
+    }
+    unsigned int nbRemoved = 0;
+    //the literals of the clauses containing the opposite of a literal
+    Array<bool> inClause(s.nbVar * 2);
+    for (Lit l = 0; l < s.nbVar * 2; l++) {
+        inClause.push(false);
+    }
+    Array<Lit> c;
+    Array<Lit> covering;
+    //the size of c and the literal used at each covered literal addition
+    Array<unsigned int> steps;
+    bool removed = true;
+    while (removed && blockedBudget > 0) {
+        removed = false;
+        for (unsigned int i = 0; i < elimClauses.getSize() && blockedBudget > 0; i++) {
+            if (elimClauses[i].getSize() < 2) {
+                continue;
+            }
+            stamp++;
+            c.pop(c.getSize());
+            for (unsigned int j = 0; j < elimClauses[i].getSize(); j++) {
+                Lit l = elimClauses[i][j];
+                litStamps[l] = stamp;
+                c.push(l);
+            }
+            steps.pop(steps.getSize());
+            Lit pivot = lit_Undef;
+            //the covered literals are only added if no literal blocks c
+            for (unsigned int pass = 0; pass < (covered ? 2U : 1U) && pivot == lit_Undef; pass++) {
+                for (unsigned int j = 0; j < c.getSize() && pivot == lit_Undef; j++) {
+                    Lit l = c[j];
+                    Lit opp = VariablesManager::oppositeLit(l);
+                    //the value of the pivot may be flipped to extend the model
+                    if (frozen[VariablesManager::getVar(l)] || nbOccurs[opp] > maxOccurrences) {
+                        continue;
+                    }
+                    bool blocked = true;
+                    covering.pop(covering.getSize());
+                    const Array<unsigned int>& occ = occurs[opp];
+                    for (unsigned int k = 0; k < occ.getSize(); k++) {
+                        const Array<Lit>& d = elimClauses[occ[k]];
+                        if (d.getSize() == 0) {
+                            continue;
+                        }
+                        blockedBudget -= d.getSize();
+                        bool tautology = false;
+                        for (unsigned int m = 0; !tautology && m < d.getSize(); m++) {
+                            tautology = d.get(m) != opp &&
+                                    litStamps[VariablesManager::oppositeLit(d.get(m))] == stamp;
+                        }
+                        if (tautology) {
+                            continue;
+                        }
+                        if (pass == 0) {
+                            blocked = false;
+                            break;
+                        }
+                        //the covered literals are in every non tautological
+                        //resolvent, but not in c
+                        if (blocked) {
+                            for (unsigned int m = 0; m < d.getSize(); m++) {
+                                if (d.get(m) != opp && litStamps[d.get(m)] != stamp) {
+                                    covering.push(d.get(m));
+                                }
+                            }
+                        } else {
+                            for (unsigned int m = 0; m < d.getSize(); m++) {
+                                inClause[d.get(m)] = true;
+                            }
+                            unsigned int nb = 0;
+                            for (unsigned int m = 0; m < covering.getSize(); m++) {
+                                if (inClause[covering[m]]) {
+                                    covering[nb++] = covering[m];
+                                }
+                            }
+                            covering.pop(covering.getSize() - nb);
+                            for (unsigned int m = 0; m < d.getSize(); m++) {
+                                inClause[d.get(m)] = false;
+                            }
+                        }
+                        blocked = false;
+                        if (covering.getSize() == 0) {
+                            break;
+                        }
+                    }
+                    if (blocked) {
+                        pivot = l;
+                    } else if (covering.getSize() > 0 && c.getSize() + covering.getSize() <= maxCoveredSize) {
+                        //c can be extended with the covered literals, l being
+                        //flipped if the smaller clause isn't satisfied
+                        steps.push(c.getSize());
+                        steps.push(l);
+                        for (unsigned int m = 0; m < covering.getSize(); m++) {
+                            litStamps[covering[m]] = stamp;
+                            c.push(covering[m]);
+                        }
+                    }
+                }
+            }
+            if (pivot == lit_Undef) {
+                continue;
+            }
+            //the extension stack is read backward: the extended clause is
+            //satisfied first, then each smaller one by flipping its literal
+            for (unsigned int k = 0; k < steps.getSize(); k += 2) {
+                pushExtension(c, steps[k], steps[k + 1]);
+            }
+            pushExtension(c, c.getSize(), pivot);
+            clearElimClause(i);
+            nbRemoved++;
+            if (steps.getSize() > 0) {
+                nbCoveredClauses++;
+            }
+            removed = true;
+        }
+    }
+    nbBlockedClauses += nbRemoved;
+    return nbRemoved;
+}
+
+unsigned int Simplifier::substituteEquivalences() {
+    buildOccurrences();
+    if (s.state != wUnknown) {
+        return 0;
+    }
+    Array<Lit> representative(s.nbVar * 2);
+    if (!computeRepresentatives(representative)) {
+        s.state = wFalse;
+        return 0;
+    }
+    unsigned int nbSubstituted = 0;
+    for (Var v = 0; v < s.nbVar; v++) {
+        Lit l = VariablesManager::getLit(v, true);
+        Lit r = representative[l];
+        if (r == l) {
+            continue;
+        }
+        ASSERT(!frozen[v]);
+        eliminated[v] = true;
+        nbSubstituted++;
+        //l and r are given the same value by the clauses l -r and -l r
+        extensionStack.push(2);
+        extensionStack.push(l);
+        extensionStack.push(VariablesManager::oppositeLit(r));
+        extensionStack.push(2);
+        extensionStack.push(VariablesManager::oppositeLit(l));
+        extensionStack.push(r);
+    }
+    if (nbSubstituted == 0) {
+        return 0;
+    }
+    Array<Lit> c;
+    unsigned int nbClauses = elimClauses.getSize();
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        bool substituted = false;
+        for (unsigned int j = 0; !substituted && j < elimClauses[i].getSize(); j++) {
+            Lit l = elimClauses[i][j];
+            substituted = representative[l] != l;
+        }
+        if (!substituted) {
+            continue;
+        }
+        stamp++;
+        c.pop(c.getSize());
+        bool tautology = false;
+        for (unsigned int j = 0; !tautology && j < elimClauses[i].getSize(); j++) {
+            Lit r = representative[elimClauses[i][j]];
+            if (litStamps[VariablesManager::oppositeLit(r)] == stamp) {
+                tautology = true;
+            } else if (litStamps[r] != stamp) {
+                litStamps[r] = stamp;
+                c.push(r);
+            }
+        }
+        //a tautology is satisfied as soon as the equivalences are
+        clearElimClause(i);
+        if (!tautology) {
+            addElimClause(c);
+        }
+    }
+    nbSubstitutedVars += nbSubstituted;
+    return nbSubstituted;
+}
+
+bool Simplifier::computeRepresentatives(Array<Lit>& representative) {
+    unsigned int nbLits = s.nbVar * 2;
+    //the implication graph: a binary clause a b gives -a -> b and -b -> a
+    Array<unsigned int> start(nbLits + 1);
+    for (unsigned int i = 0; i <= nbLits; i++) {
+        start.push(0U);
+    }
+    for (unsigned int i = 0; i < elimClauses.getSize(); i++) {
+        const Array<Lit>& c = elimClauses[i];
+        if (c.getSize() == 2) {
+            start[VariablesManager::oppositeLit(c.get(0)) + 1]++;
+            start[VariablesManager::oppositeLit(c.get(1)) + 1]++;
+        }
+    }
+    for (unsigned int i = 0; i < nbLits; i++) {
+        start[i + 1] += start[i];
+    }
+    Array<Lit> edges(start[nbLits]);
+    for (unsigned int i = 0; i < start[nbLits]; i++) {
+        edges.push(lit_Undef);
+    }
+    Array<unsigned int> fill(nbLits);
+    for (unsigned int i = 0; i < nbLits; i++) {
+        fill.push(start[i]);
+    }
+    for (unsigned int i = 0; i < elimClauses.getSize(); i++) {
+        const Array<Lit>& c = elimClauses[i];
+        if (c.getSize() == 2) {
+            edges[fill[VariablesManager::oppositeLit(c.get(0))]++] = c.get(1);
+            edges[fill[VariablesManager::oppositeLit(c.get(1))]++] = c.get(0);
+        }
+    }
+
+    //the algorithm of Tarjan, without recursion
+    const unsigned int unvisited = std::numeric_limits<unsigned int>::max();
+    Array<unsigned int> index(nbLits);
+    Array<unsigned int> low(nbLits);
+    Array<bool> onStack(nbLits);
+    for (Lit l = 0; l < nbLits; l++) {
+        representative.push(l);
+        index.push(unvisited);
+        low.push(0U);
+        onStack.push(false);
+    }
+    Array<Lit> component;
+    Array<Lit> callStack;
+    Array<unsigned int> nextEdge;
+    unsigned int counter = 0;
+    for (Lit root = 0; root < nbLits; root++) {
+        if (index[root] != unvisited) {
+            continue;
+        }
+        index[root] = low[root] = counter++;
+        component.push(root);
+        onStack[root] = true;
+        callStack.push(root);
+        nextEdge.push(start[root]);
+        while (callStack.getSize() > 0) {
+            Lit l = callStack.getLast();
+            unsigned int& pos = nextEdge[nextEdge.getSize() - 1];
+            if (pos < start[l + 1]) {
+                Lit m = edges[pos];
+                pos++;
+                if (index[m] == unvisited) {
+                    index[m] = low[m] = counter++;
+                    component.push(m);
+                    onStack[m] = true;
+                    callStack.push(m);
+                    nextEdge.push(start[m]);
+                } else if (onStack[m] && index[m] < low[l]) {
+                    low[l] = index[m];
+                }
+                continue;
+            }
+            callStack.pop();
+            nextEdge.pop();
+            if (callStack.getSize() > 0 && low[l] < low[callStack.getLast()]) {
+                low[callStack.getLast()] = low[l];
+            }
+            if (low[l] != index[l]) {
+                continue;
+            }
+            //l is the root of a component, made of the literals above it
+            unsigned int first = component.getSize();
+            do {
+                first--;
+            } while (component[first] != l);
+            stamp++;
+            for (unsigned int i = first; i < component.getSize(); i++) {
+                litStamps[component[i]] = stamp;
             }
+            Lit rep = lit_Undef;
+            bool repFrozen = false;
+            for (unsigned int i = first; i < component.getSize(); i++) {
+                Lit m = component[i];
+                if (litStamps[VariablesManager::oppositeLit(m)] == stamp) {
+                    //m is equivalent to -m
+                    return false;
+                }
+                bool mFrozen = frozen[VariablesManager::getVar(m)];
+                if (rep == lit_Undef || (mFrozen && !repFrozen) ||
+                        (mFrozen == repFrozen && m < rep)) {
+                    rep = m;
+                    repFrozen = mFrozen;
+                }
+            }
+            for (unsigned int i = first; i < component.getSize(); i++) {
+                Lit m = component[i];
+                onStack[m] = false;
+                if (!frozen[VariablesManager::getVar(m)]) {
+                    representative[m] = rep;
+                }
+            }
+            component.pop(component.getSize() - first);
+        }
+    }
+    return true;
+}
+
+void Simplifier::buildOccurrences() {
+    if (occurrencesBuilt) {
+        return;
+    }
+    occurrencesBuilt = true;
+    ASSERT_EQUAL(0U, s.assignLevel);
+    while (occurs.getSize() < s.nbVar * 2) {
+        //most literals only appear in a few clauses
+        occurs.push(Array<unsigned int>(4));
+        nbOccurs.push(0U);
+        litStamps.push(0U);
+    }
+    while (frozen.getSize() < s.nbVar) {
+        frozen.push(false);
+    }
+    while (eliminated.getSize() < s.nbVar) {
+        eliminated.push(false);
+    }
+    Array<Lit> c;
+    Array<Lit> binaries;
+    //the binary clauses are only present in the watches
+    for (Lit l = 0; l < s.nbVar * 2; l++) {
+        if (s.assign[VariablesManager::getVar(l)] != wUnknown) continue;
+        binaries.pop(binaries.getSize());
+        s.getBinaryWith(l, binaries);
+        for (unsigned int j = 0; j < binaries.getSize(); j++) {
+            Lit tmp = binaries.get(j);
+            if (tmp < l && s.assign[VariablesManager::getVar(tmp)] == wUnknown) {
+                c.pop(c.getSize());
+                c.push(l);
+                c.push(tmp);
+                addElimClause(c);
+            }
+        }
+    }
+    for (unsigned int i = 0; i < s.clauses.getSize(); i++) {
+        const Clause& cl = s.arena[s.clauses.get(i)];
+        c.pop(c.getSize());
+        bool satisfied = false;
+        for (unsigned int j = 0; !satisfied && j < cl.getSize(); j++) {
+            wbool value = s.litValues[cl.getLit(j)];
+            if (value == wTrue) {
+                satisfied = true;
+            } else if (value == wUnknown) {
+                c.push(cl.getLit(j));
+            }
+        }
+        if (satisfied) {
+            continue;
+        }
+        if (c.getSize() == 0) {
+            //an empty entry would be taken for a removed clause
+            s.state = wFalse;
+            return;
+        }
+        addElimClause(c);
+    }
+}
+
+void Simplifier::addElimClause(const Array<Lit>& c) {
+    unsigned int idx = elimClauses.getSize();
+    elimClauses.push(Array<Lit>(c.getSize()));
+    for (unsigned int i = 0; i < c.getSize(); i++) {
+        elimClauses[idx].push(c.get(i));
+        occurs[c.get(i)].push(idx);
+        nbOccurs[c.get(i)]++;
+    }
+}
+
+void Simplifier::removeElimClause(unsigned int idx, Lit pivot) {
+    ASSERT(elimClauses[idx].getSize() > 0);
+    pushExtension(elimClauses[idx], elimClauses[idx].getSize(), pivot);
+    clearElimClause(idx);
+}
+
+void Simplifier::pushExtension(const Array<Lit>& c, unsigned int sz, Lit pivot) {
+    extensionStack.push(sz);
+    extensionStack.push(pivot);
+    for (unsigned int i = 0; i < sz; i++) {
+        if (c.get(i) != pivot) {
+            extensionStack.push(c.get(i));
         }
     }
 }
+
+void Simplifier::clearElimClause(unsigned int idx) {
+    Array<Lit>& c = elimClauses[idx];
+    for (unsigned int i = 0; i < c.getSize(); i++) {
+        Lit l = c.get(i);
+        ASSERT(nbOccurs[l] > 0);
+        nbOccurs[l]--;
+    }
+    for (unsigned int i = 0; i < c.getSize(); i++) {
+        touch(VariablesManager::getVar(c.get(i)));
+    }
+    //the occurrence lists are cleaned lazily
+    c.pop(c.getSize());
+}
+
+bool Simplifier::eliminate(Var v) {
+    if (frozen[v] || eliminated[v] || s.assign[v] != wUnknown) {
+        return false;
+    }
+    Lit pos = VariablesManager::getLit(v, true);
+    Lit neg = VariablesManager::getLit(v, false);
+    unsigned int nbClauses = nbOccurs[pos] + nbOccurs[neg];
+    if (nbClauses == 0 || (nbOccurs[pos] > 0 && nbOccurs[neg] > 0 && nbClauses > maxOccurrences)) {
+        return false;
+    }
+    //remove the clauses that were removed from the occurrence lists
+    for (unsigned int k = 0; k < 2; k++) {
+        Array<unsigned int>& occ = occurs[k == 0 ? pos : neg];
+        unsigned int j = 0;
+        for (unsigned int i = 0; i < occ.getSize(); i++) {
+            if (elimClauses[occ[i]].getSize() > 0) {
+                occ[j++] = occ[i];
+            }
+        }
+        occ.pop(occ.getSize() - j);
+    }
+    const Array<unsigned int>& posOcc = occurs[pos];
+    const Array<unsigned int>& negOcc = occurs[neg];
+    ASSERT_EQUAL(nbOccurs[pos], posOcc.getSize());
+    ASSERT_EQUAL(nbOccurs[neg], negOcc.getSize());
+    Array<Array<Lit> > resolvents;
+    Array<Lit> resolvent;
+    for (unsigned int i = 0; i < posOcc.getSize(); i++) {
+        for (unsigned int j = 0; j < negOcc.getSize(); j++) {
+            const Array<Lit>& a = elimClauses[posOcc[i]];
+            const Array<Lit>& b = elimClauses[negOcc[j]];
+            elimBudget -= a.getSize() + b.getSize();
+            if (resolve(a, b, v, resolvent)) {
+                //a unit resolvent would need to be propagated
+                if (resolvent.getSize() < 2 || resolvent.getSize() > maxResolventSize ||
+                        resolvents.getSize() >= nbClauses) {
+                    return false;
+                }
+                resolvents.push(Array<Lit>(resolvent.getSize()));
+                for (unsigned int k = 0; k < resolvent.getSize(); k++) {
+                    resolvents[resolvents.getSize() - 1].push(resolvent[k]);
+                }
+            }
+        }
+    }
+    //v is replaced by its resolvents
+    eliminated[v] = true;
+    Array<unsigned int> toRemove(nbClauses);
+    for (unsigned int i = 0; i < posOcc.getSize(); i++) {
+        toRemove.push(posOcc[i]);
+    }
+    for (unsigned int i = 0; i < negOcc.getSize(); i++) {
+        toRemove.push(negOcc[i]);
+    }
+    for (unsigned int i = 0; i < toRemove.getSize(); i++) {
+        unsigned int idx = toRemove[i];
+        removeElimClause(idx, i < posOcc.getSize() ? pos : neg);
+    }
+    occurs[pos].pop(occurs[pos].getSize());
+    occurs[neg].pop(occurs[neg].getSize());
+    for (unsigned int i = 0; i < resolvents.getSize(); i++) {
+        addElimClause(resolvents[i]);
+        for (unsigned int j = 0; j < resolvents[i].getSize(); j++) {
+            touch(VariablesManager::getVar(resolvents[i][j]));
+        }
+    }
+    return true;
+}
+
+bool Simplifier::resolve(const Array<Lit>& a, const Array<Lit>& b, Var v, Array<Lit>& resolvent) {
+    stamp++;
+    resolvent.pop(resolvent.getSize());
+    for (unsigned int i = 0; i < a.getSize(); i++) {
+        Lit l = a.get(i);
+        if (VariablesManager::getVar(l) != v) {
+            litStamps[l] = stamp;
+            resolvent.push(l);
+        }
+    }
+    for (unsigned int i = 0; i < b.getSize(); i++) {
+        Lit l = b.get(i);
+        if (VariablesManager::getVar(l) == v || litStamps[l] == stamp) {
+            continue;
+        }
+        if (litStamps[VariablesManager::oppositeLit(l)] == stamp) {
+            return false;
+        }
+        resolvent.push(l);
+    }
+    return true;
+}
+
+void Simplifier::touch(Var v) {
+    if (frozen[v] || eliminated[v] || s.assign[v] != wUnknown) {
+        return;
+    }
+    if (elimQueue.contains(v)) {
+        elimQueue.updateValue(v);
+    } else {
+        elimQueue.add(v);
+    }
+}
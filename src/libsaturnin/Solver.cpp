@@ -4,7 +4,7 @@
 #include "saturnin/Assert.h"            // for ASSERT, ASSERT_EQUAL, SKIP
 #include "saturnin/Clause.h"            // for Clause, watcher_t, etc
 #include "saturnin/ClauseAllocator.h"   // for ClauseAllocator
-#include "saturnin/Fifo.h"              // for Fifo
+#include "saturnin/ClauseArena.h"       // for ClauseArena
 #include "saturnin/Heap.h"              // for Heap
 #include "saturnin/Logger.h"            // for Logger
 #include "saturnin/Mean.h"              // for Mean
@@ -21,6 +21,7 @@
 #include <limits>                       // for numeric_limits
 #include <cstring>                      // for memcpy
 #include <cinttypes>                    // for PRIu64
+#include <algorithm>                    // for sort
 
 #include "../Utils.h"                   // for SATURNIN_BEGIN_PROFILE, etc
 
@@ -34,26 +35,41 @@ dbFileName
 ) :
 asyncStop(false),
 #ifdef PROFILE
-__profile_propagateMono(0), __profile_propagateBin(0), __profile_propagateWatched(0),
-__profile_reduce(0), __profile_analyze(0), __profile_simplify(0),
+__profile_propagate(0), __profile_reduce(0), __profile_analyze(0), __profile_simplify(0), __profile_decide(0), __profile_subsume(0), __profile_probe(0),
+__profile_visits(),
 #endif /* PROFILE */
 nbVar(i),
-varLevel(nbVar), assign(nbVar), presumption(nbVar), phase(nbVar), previousPhase(nbVar),
-phaseHammingDistance(0), lastReduceSeen(nbVar), nbVarSeenBtwReduce(0), minDeviation(100.0),
-binReasons(nbVar * 3), nbBin(0), reasons(nbVar), binWatched(nbVar * 2),
-watchedClauses(nbVar * 2), monowatch(nbVar * 2), varActivityValue(nbVar),
-varActivity(nbVar, VSIDSComp(*this)),
+varData(nbVar), assign(nbVar), litValues(nbVar * 2 + LiteralSearch::padding), presumption(nbVar), phase(nbVar), previousPhase(nbVar),
+phaseHammingDistance(0), targetPhase(nbVar), bestPhase(nbVar), targetTrailSize(0), bestTrailSize(0),
+targetPhases(false), rephasing(false), nbRephases(0), nextRephase(1000), rephaseInterval(1000),
+lastReduceSeen(nbVar), nbVarSeenBtwReduce(0), minDeviation(100.0),
+binReasons(nbVar * 4), nbBin(0), watches(nbVar * 2),
+varActivityValue(nbVar),
+varActivity(nbVar, VSIDSComp(*this)), unassignedVars(nbVar),
 vsidsInc(1.0), vsidsDec(0.95),
-clauses(nbClauses), learntClauses(1024),
-propagationQueue(128), stack(nbVar), stackPointer(256), assignLevel(0),
+branching(BranchingHeuristic::VSIDS), vmtfLinks(nbVar), vmtfFirst(var_Undef), vmtfLast(var_Undef),
+vmtfSearch(var_Undef), vmtfStamp(0), vmtfBumped(64), lrbData(nbVar),
+lrbStep(0.4), lrbMinStep(0.06), lrbDecayFactor(0.95), lrbDecays(256), nbDecisions(0),
+clauses(nbClauses), learntClauses(1024), removedClauses(1024), removedTernaries(16),
+stack(nbVar), propagationHead(0), stackPointer(256), assignLevel(0),
+chronoThreshold(0), nbChronoBacktrack(0), keptLiterals(64),
 nbLitRemoved(0),
 nbConfBeforeReduce(500), reduceIncrement(100), reduceLimit(500),
 nbReducePerformed(0), nbClauseRemoved(0),
+vivification(true), vivifyEffort(0.1), lastVivifyPropag(0), nbVivifiedLits(0),
+subsumption(true), subsumeBudget(20000000), nextSubsume(0), subsumeInterval(10000),
+nbSubsumedClauses(0), nbStrengthenedClauses(0),
+probing(true), probeBudget(2000000), nextProbe(0), probeInterval(10000), nextProbeVar(0),
+nbFailedLiterals(0), nbProbedUnits(0), nbProbedEquivalences(0), nbHyperBinaries(0),
+transitiveReduction(true), transitiveBudget(2000000), nextTransitiveLit(0), nbTransitiveBinaries(0),
+binaryMinimization(true), binaryMinimizationSize(30), binaryMinimizationLBD(6), nbMinimizedLits(0), nbBinaryMinimizedLits(0),
+onTheFlySubsumption(true), otfsReasons(16), otfsPivots(16), otfsAsserting(CRef_Undef), otfsAssertingSize(0),
+nbOnTheFlyStrengthened(0), nbOnTheFlyLearnt(0),
 localLbdAverageLength(50), lbdDifferenceFactor(0.8), lbdMean(), stackSize(5000), stackDifferenceFactor(1.4),
-restarts(0), nbPropag(0), conflicts(0), state(wUnknown),
+restarts(0), nbReusedLevels(0), reuseTrail(true), nbPropag(0), conflicts(0), state(wUnknown),
 uvalue(1), vvalue(1), factor(512),
-allocator(10, 16), levelLBDChecked(nbVar), lbdTimeStamp(0), lbdValues(25),
-seen(nbVar), map(nbVar), revertMap(nbVar), nextVarMap(0),
+arena(nbClauses * 8), garbageFraction(0.2), nbGarbageCollect(0), levelLBDChecked(nbVar), lbdTimeStamp(0), lbdValues(25),
+map(nbVar), revertMap(nbVar), nextVarMap(0), extensionStack(0), model(0),
 pureLitSearch(nbVar * 2), nbPureLitSearch(0), nbPureLitFound(0),
 nbInitialClausesReduced(0), nbInitialClausesRemoved(0), verbosity(1)
 #ifdef SATURNIN_PARALLEL
@@ -69,19 +85,58 @@ nbInitialClausesReduced(0), nbInitialClausesRemoved(0), verbosity(1)
     ensureCapacity(nbVar - 1, 0);
     ASSERT_EQUAL(nbVar, assign.getSize());
     stackPointer.push(0);
+    double decay = 1.0;
+    for (unsigned int k = 0; k < lrbDecays.getCapacity(); k++) {
+        lrbDecays.push(decay);
+        decay *= lrbDecayFactor;
+    }
 }
 
 Solver::~Solver() {
-    while (clauses.getSize() > 0) {
-        Clause* a = clauses.get(clauses.getSize() - 1);
-        clauses.pop();
-        allocator.releaseClause(a);
+    //the clauses are released along with the arena
+}
+
+bool Solver::assignUnit(Lit l) {
+    ASSERT_EQUAL((unsigned int) 0, assignLevel);
+    Var v = VariablesManager::getVar(l);
+    wbool b = VariablesManager::getLitSign(l) ? wTrue : wFalse;
+    //Check if we didn't prove the opposite literal
+    if (assign[v] != wUnknown && assign[v] != b) {
+        //we try to add the fact l where we already know ¬l
+        state = wFalse;
+        return false;
     }
-    while (learntClauses.getSize() > 0) {
-        Clause* a = learntClauses.get(learntClauses.getSize() - 1);
-        learntClauses.pop();
-        allocator.releaseClause(a);
+    assign[v] = b;
+    litValues[l] = wTrue;
+    litValues[VariablesManager::oppositeLit(l)] = wFalse;
+    phase[v] = b;
+    varData[v].level = 0;
+    stack.push(l);
+
+#ifdef SATURNIN_DB
+    Lit dbC[2];
+    dbC[0] = l;
+    dbC[1] = std::numeric_limits<Lit>::max();
+    long id = db.nbClausesAdded();
+    db.addClause(dbC, id);
+#endif
+    return true;
+}
+
+bool Solver::propagateUnits() {
+    Lit* conflict = propagate();
+    if (conflict != nullptr) {
+#ifdef SATURNIN_DB
+        //compute the reason of the conflict and add the empty clause to
+        //the database
+        Array<Lit> learnt(2);
+        computeLearntClause(conflict, learnt);
+        db.addClause(&lit_Undef, db.nbClausesAdded());
+#endif /* SATURNIN_DB */
+        state = wFalse;
+        return false;
     }
+    return true;
 }
 
 bool Solver::addClause(const Lit * const literals, unsigned int sz, bool mapped) {
@@ -92,6 +147,7 @@ bool Solver::addClause(const Lit * const literals, unsigned int sz, bool mapped)
     //now
     if (state == wTrue) {
         state = wUnknown;
+        model.pop(model.getSize());
     }
 #ifdef SATURNIN_DB
     mapped = mapped || db.isInitialized();
@@ -104,56 +160,13 @@ bool Solver::addClause(const Lit * const literals, unsigned int sz, bool mapped)
         }
     } else {
         for (unsigned int i = 0; i < sz; i++) {
-            Var v = VariablesManager::getVar(literals[i]);
-            ensureCapacity(v, nbVar);
-            if (map[v] == var_Undef) {
-                map[v] = nextVarMap;
-                revertMap[nextVarMap] = v;
-                nextVarMap++;
-            }
-            internalClause[i] = VariablesManager::getLit(map[v], VariablesManager::getLitSign(literals[i]));
+            internalClause[i] = mapLit(literals[i]);
         }
     }
     if (sz == 1) {
         Lit l = internalClause[0];
-        Var v = VariablesManager::getVar(l);
-        wbool b = VariablesManager::getLitSign(l) ? wTrue : wFalse;
-        ensureCapacity(v, nbVar);
-
-        //Check if we didn't prove the opposite literal
-        if (assign[v] != wUnknown && assign[v] != b) {
-            //we try to add the fact l where we already know ¬l
-            state = wFalse;
-            return false;
-        }
-        assign[v] = b;
-        phase[v] = b;
-        varLevel[v] = 0;
-        propagationQueue.push(VariablesManager::oppositeLit(l));
-        stack.push(l);
-        
-#ifdef SATURNIN_DB
-        Lit dbC[2];
-        dbC[0] = l;
-        dbC[1] = std::numeric_limits<Lit>::max();
-        long id = db.nbClausesAdded();
-        db.addClause(dbC, id);
-#endif
-
-        Lit* conflict = propagate();
-        if(conflict != nullptr) {
-#ifdef SATURNIN_DB
-            //compute the reason of the conflict and add the empty clause to
-            //the database
-            Array<Lit> learnt(2);
-            computeLearntClause(conflict, learnt);
-            db.addClause(&lit_Undef, db.nbClausesAdded());
-#endif /* SATURNIN_DB */
-            state = wFalse;
-            return false;
-        } else {
-            return true;
-        }
+        ensureCapacity(VariablesManager::getVar(l), nbVar);
+        return assignUnit(l) && propagateUnits();
     } else if (sz == 2) {
         Lit a = internalClause[0];
         Var va = VariablesManager::getVar(a);
@@ -184,8 +197,7 @@ bool Solver::addClause(const Lit * const literals, unsigned int sz, bool mapped)
             }
         }
 
-        binWatched[a].push(b);
-        binWatched[b].push(a);
+        addBinaryWatch(a, b);
         
 #ifdef SATURNIN_DB
         Lit clDB[3];
@@ -247,23 +259,11 @@ bool Solver::addClause(const Lit * const literals, unsigned int sz, bool mapped)
             return addClause((const Lit*) tmp, 2, true);
         }
 
-        //TODO: check that the clause doesn't already exist
+        //the clauses that already exist are removed by subsume
 
-        //TODO: use a more intelligent sort, and do it before in order
-        //      the operation in O(n log) instead of O(n²) (and even O(n)?)
-        //      the intelligent sort must be fast for integers that all have
-        //      different values
-        for (unsigned int k = 0; k < tmp.getSize(); k++) {
-            for (unsigned int l = k + 1; l < tmp.getSize(); l++) {
-                if (tmp[k] > tmp[l]) {
-                    Lit t = tmp[k];
-                    tmp[k] = tmp[l];
-                    tmp[l] = t;
-                }
-            }
-        }
+        sortLits((Lit*) tmp, tmp.getSize());
 
-        Clause* newClause = allocator.createClause(tmp);
+        CRef newClause = arena.createClause(tmp);
         addWatchedClause(newClause);
 
 
@@ -271,38 +271,37 @@ bool Solver::addClause(const Lit * const literals, unsigned int sz, bool mapped)
 
         clauses.push(newClause);
 #ifdef SATURNIN_DB
-        db.addClause((Lit*)newClause, db.nbClausesAdded());
+        db.addClause(arena[newClause].lits(), db.nbClausesAdded());
 #endif /* SATURNIN_NODB */
 
     }
     return true;
 }
 
-Clause* Solver::addLearntClause(const Array<Lit>& clause) {
+CRef Solver::addLearntClause(const Array<Lit>& clause) {
 
     ASSERT(clause.getSize() > 0);
     if (clause.getSize() == 1) {
         enqueue(clause[0U]);
-        return nullptr;
+        return CRef_Undef;
     } else if (clause.getSize() == 2) {
         Lit a = clause[0U];
         Var va = VariablesManager::getVar(a);
         Lit b = clause[1U];
-        binWatched[a].push(b);
-        binWatched[b].push(a);
+        addBinaryWatch(a, b);
         nbBin++;
-        binReasons[3 * va] = a;
-        binReasons[3 * va + 1] = b;
-        ASSERT_EQUAL(lit_Undef, binReasons[3 * va + 2]);
-        Lit* reason = ((Lit*) binReasons) + 3 * va;
-        enqueue(a, reason);
+        binReasons[4 * va] = a;
+        binReasons[4 * va + 1] = b;
+        binReasons[4 * va + 2] = lit_Undef;
+        ASSERT_EQUAL(lit_Undef, binReasons[4 * va + 3]);
+        enqueue(a, binaryReason);
 #ifdef SATURNIN_DB
-        db.addClause((Lit*)reason, db.nbClausesAdded());
+        db.addClause(((Lit*) binReasons) + 4 * va, db.nbClausesAdded());
 #endif /* SATURNIN_DB */
-        return nullptr;
+        return CRef_Undef;
     } else {
-        Clause* newClause = allocator.createClause(clause);
-        addWatchedClause(newClause);
+        CRef ref = arena.createClause(clause);
+        Clause* newClause = &arena[ref];
 
         ASSERT(newClause->isAttached());
 
@@ -312,12 +311,15 @@ Clause* Solver::addLearntClause(const Array<Lit>& clause) {
             lbdValues.push(0);
         }
         lbdValues[lbd]++;
+        //the lbd must be set before watching the clause so that a learnt
+        //clause of size 3 isn't taken for an initial ternary clause
         newClause->setLBD(lbd);
+        addWatchedClause(ref);
 
         newClause->setIndex(learntClauses.getSize());
-        learntClauses.push(newClause);
+        learntClauses.push(ref);
 #ifdef SATURNIN_DB
-        db.addClause((Lit*)newClause, db.nbClausesAdded());
+        db.addClause(newClause->lits(), db.nbClausesAdded());
 #endif /* SATURNIN_DB */
         ASSERT(newClause->isLearnt());
 
@@ -325,9 +327,9 @@ Clause* Solver::addLearntClause(const Array<Lit>& clause) {
 
         //TODO: check if we must export the clause
 
-        enqueue(clause[0U], newClause->lits());
+        enqueue(clause[0U], ref);
 
-        return newClause;
+        return ref;
     }
 
 }
@@ -338,7 +340,7 @@ unsigned int Solver::computeLBD(Clause* clause) {
     for (unsigned int i = 0; i < clause->getSize() && lbd < SATURNIN_MAX_LBD_VALUE; i++) {
         Var v = VariablesManager::getVar(clause->getLit(i));
         //compute the lbd
-        unsigned int varLvl = varLevel[v];
+        unsigned int varLvl = varData[v].level;
         if (levelLBDChecked[varLvl] != lbdTimeStamp) {
             levelLBDChecked[varLvl] = lbdTimeStamp;
             lbd++;
@@ -347,18 +349,13 @@ unsigned int Solver::computeLBD(Clause* clause) {
     return lbd;
 }
 
-void Solver::removeLearntClause(Clause* c) {
+void Solver::removeLearntClause(CRef ref) {
 
     nbClauseRemoved++;
+    Clause* c = &arena[ref];
     ASSERT(c->isLearnt());
     ASSERT(c->getSize() > 1);
 
-    //Remove the clause from the watched structures
-    if (c->isAttached()) {
-        stopWatchClause(c->getLit(0), c);
-        stopWatchClause(c->getLit(1), c);
-    }
-
 
     //Remove the clause from the learntClauses list by putting it at the end
     //of the list and then 'popping' it
@@ -366,60 +363,218 @@ void Solver::removeLearntClause(Clause* c) {
     ASSERT(learntClauses.getSize() != 0);
     unsigned int last = learntClauses.getSize() - 1;
     ASSERT(i <= last);
-    ASSERT(c == learntClauses[i]);
+    ASSERT(ref == learntClauses[i]);
     if (i != last) {
-        Clause* tmp = learntClauses[last];
+        CRef tmp = learntClauses[last];
         //put clause c as last element in the learnt clauses vector
         learntClauses[i] = tmp;
-        tmp->setIndex(i);
+        arena[tmp].setIndex(i);
 #ifdef DEBUG
-        learntClauses[last] = c;
+        learntClauses[last] = ref;
 #endif /* DEBUG */
     }
-    ASSERT(c == learntClauses[last]);
+    ASSERT(ref == learntClauses[last]);
     learntClauses.pop();
 
     ASSERT(lbdValues[c->getLBD()] > 0);
     lbdValues[c->getLBD()]--;
 
-    //Remove the clause from memory
-    allocator.releaseClause(c);
+    if (c->isAttached()) {
+        //the watchers will be dropped during the walk over the watch lists
+        c->setToRemove(true);
+        removedClauses.push(ref);
+    } else {
+        //a frozen clause is removed while its only watcher is visited
+        arena.releaseClause(ref);
+    }
+}
+
+void Solver::removeClause(CRef ref) {
+    Clause& c = arena[ref];
+    ASSERT(!c.isToRemove());
+    if (isTernaryWatched(c)) {
+        //the inline watchers hold no reference, they are recognized by their
+        //literals. Until then, they only propagate an implied clause
+        for (unsigned int i = 0; i < 3; i++) {
+            RemovedTernary t;
+            t.watched = c.getLit(i);
+            t.a = std::min(c.getLit((i + 1) % 3), c.getLit((i + 2) % 3));
+            t.b = std::max(c.getLit((i + 1) % 3), c.getLit((i + 2) % 3));
+            t.dropped = false;
+            removedTernaries.push(t);
+        }
+        arena.releaseClause(ref);
+    } else {
+        c.setToRemove(true);
+        removedClauses.push(ref);
+    }
+}
+
+void Solver::cleanWatches() {
+    if (removedTernaries.getSize() > 0) {
+        RemovedTernary* first = removedTernaries;
+        RemovedTernary* last = first + removedTernaries.getSize();
+        std::sort(first, last);
+        for (RemovedTernary* group = first; group != last;) {
+            Lit l = group->watched;
+            RemovedTernary* groupEnd = group;
+            while (groupEnd != last && groupEnd->watched == l) {
+                groupEnd++;
+            }
+            watcher_t* current = watches[l];
+            watcher_t* dest = current;
+            watcher_t* end = current + watches[l].getSize();
+            for (; current != end; current++) {
+                if (current->isTernary()) {
+                    RemovedTernary key;
+                    key.watched = l;
+                    key.a = std::min(current->block, current->getOther());
+                    key.b = std::max(current->block, current->getOther());
+                    //a duplicated clause may only be removed once
+                    RemovedTernary* t = std::lower_bound(group, groupEnd, key);
+                    while (t != groupEnd && !(key < *t) && t->dropped) {
+                        t++;
+                    }
+                    if (t != groupEnd && !(key < *t)) {
+                        t->dropped = true;
+                        continue;
+                    }
+                }
+                *dest = *current;
+                dest++;
+            }
+            watches[l].pop(static_cast<unsigned int>(end - dest));
+            group = groupEnd;
+        }
+#ifdef DEBUG
+        for (RemovedTernary* t = first; t != last; t++) {
+            ASSERT(t->dropped);
+        }
+#endif /* DEBUG */
+        removedTernaries.pop(removedTernaries.getSize());
+    }
+    if (removedClauses.getSize() == 0) {
+        return;
+    }
+    for (unsigned int i = 0; i < watches.getSize(); i++) {
+        watcher_t* current = watches[i];
+        watcher_t* dest = current;
+        watcher_t* end = current + watches[i].getSize();
+        for (; current != end; current++) {
+            if (current->isImplicit() || current->isFrozen() ||
+                    isWatching(arena[current->getRef()], i)) {
+                *dest = *current;
+                dest++;
+            }
+        }
+        watches[i].pop(static_cast<unsigned int>(end - dest));
+    }
+    releaseRemovedClauses();
+}
+
+void Solver::releaseRemovedClauses() {
+    for (unsigned int i = 0; i < removedClauses.getSize(); i++) {
+        ASSERT(arena[removedClauses[i]].isToRemove());
+        arena.releaseClause(removedClauses[i]);
+    }
+    removedClauses.pop(removedClauses.getSize());
+}
+
+void Solver::addWatchedClause(CRef c) {
+    const Clause& cl = arena[c];
+    Lit a = cl.getLit(0);
+    Lit b = cl.getLit(1);
+    if (isTernaryWatched(cl)) {
+        Lit d = cl.getLit(2);
+        watches[a].push(watcher_t(d, b, watcher_t::wkTernary));
+        watches[b].push(watcher_t(d, a, watcher_t::wkTernary));
+        watches[d].push(watcher_t(b, a, watcher_t::wkTernary));
+        return;
+    }
+    watches[a].push(watcher_t(c, b));
+    watches[b].push(watcher_t(c, a));
+}
+
+void Solver::detachClause(CRef c) {
+    const Clause& cl = arena[c];
+    if (!isTernaryWatched(cl)) {
+        stopWatchClause(cl.getLit(0), c);
+        stopWatchClause(cl.getLit(1), c);
+        return;
+    }
+    for (unsigned int i = 0; i < 3; i++) {
+        Lit l = cl.getLit(i);
+        Lit a = cl.getLit((i + 1) % 3);
+        Lit b = cl.getLit((i + 2) % 3);
+        watcher_t* w = (watcher_t*) watches[l];
+        watcher_t* end = w + watches[l].getSize();
+        while (w != end && !(w->isTernary() &&
+                ((w->block == a && w->getOther() == b) ||
+                (w->block == b && w->getOther() == a)))) {
+            w++;
+        }
+        ASSERT(w != end);
+        //keep the order of the remaining watchers
+        while (w + 1 < end) {
+            *w = *(w + 1);
+            w++;
+        }
+        watches[l].pop();
+    }
 }
 
-void Solver::addWatchedClause(Clause* c) {
-    Lit a = c->getLit(0);
-    Lit b = c->getLit(1);
-    watchedClauses[a].push(watcher_t(c, b));
-    watchedClauses[b].push(watcher_t(c, a));
+void Solver::addBinaryWatch(const Lit a, const Lit b) {
+    const Lit lits[2] = {a, b};
+    for (unsigned int i = 0; i < 2; i++) {
+        Array<watcher_t>& list = watches[lits[i]];
+        list.push(watcher_t(lits[1 - i]));
+        //swap the new watcher with the first non binary one
+        unsigned int last = list.getSize() - 1;
+        unsigned int pos = 0;
+        while (pos < last && list[pos].isBinary()) {
+            pos++;
+        }
+        if (pos < last) {
+            list[last] = list[pos];
+            list[pos] = watcher_t(lits[1 - i]);
+        }
+    }
 }
 
-void Solver::stopWatchClause(const Lit l, const Clause* c) {
-    watcher_t* i = (watcher_t*) watchedClauses[l];
-    watcher_t* end = i + watchedClauses[l].getSize();
+void Solver::stopWatchClause(const Lit l, const CRef c) {
+    watcher_t* i = (watcher_t*) watches[l];
+    watcher_t* end = i + watches[l].getSize();
     while (i != end) {
-        if (i->watched == c) {
+        if (!i->isImplicit() && i->getRef() == c) {
             while (i + 1 != end) {
                 *i = *(i + 1);
                 i++;
             }
-            watchedClauses[l].pop();
+            watches[l].pop();
             return;
         }
         i++;
     }
 }
 
+void Solver::getBinaryWith(Lit l, Array<Lit>& binaries) const {
+    const Array<watcher_t>& ws = watches.get(l);
+    for (unsigned int i = 0; i < ws.getSize(); i++) {
+        if (ws.get(i).isBinary()) {
+            binaries.push(ws.get(i).block);
+        }
+    }
+}
+
 bool Solver::reduceClauseEval(const Clause* c, unsigned int medianLBD, int maxToBeUsefull, int& trueLits) {
     bool containsProvenLit = c->getLBD() > medianLBD;
     if (c->getLBD() >= 3) {
         for (unsigned int j = 0; j < c->getSize() && !containsProvenLit && trueLits <= maxToBeUsefull; j++) {
             Lit l = c->getLit(j);
-            Var v = VariablesManager::getVar(l);
             //check if the clause doesn't contain any proven literal
-            containsProvenLit = assign[v] != wUnknown &&
-                    assign[v] == (VariablesManager::getLitSign(l) ? wTrue : wFalse);
+            containsProvenLit = litValues[l] == wTrue;
 
-            if (phase[v] == (VariablesManager::getLitSign(l) ? wTrue : wFalse)) {
+            if (phase[VariablesManager::getVar(l)] == (VariablesManager::getLitSign(l) ? wTrue : wFalse)) {
                 trueLits++;
             }
         }
@@ -452,7 +607,7 @@ void Solver::reduce() {
     medianLBD+=2;
 
     ASSERT_EQUAL(assignLevel, 0U);
-    ASSERT_EQUAL(0U, propagationQueue.getSize());
+    ASSERT_EQUAL(stack.getSize(), propagationHead);
 
     //compute the hamming distance
     phaseHammingDistance = 0;
@@ -478,13 +633,14 @@ void Solver::reduce() {
     phaseHammingDistance = 0;
     nbVarSeenBtwReduce = 0;
 
-    Array<Clause*> toDesactivate;
+    Array<CRef> toDesactivate;
 
     unsigned int i = learntClauses.getSize() - 1;
 
     while (i < learntClauses.getSize() && !Solver::asyncStop) {
 
-        Clause* c = learntClauses[i];
+        CRef ref = learntClauses[i];
+        Clause* c = &arena[ref];
 
         if (!c->isAttached()) {
             //we will deal with those later
@@ -503,14 +659,17 @@ void Solver::reduce() {
 
         if (containsProvenLit) {
             //clause is useless
-            removeLearntClause(c);
+            removeLearntClause(ref);
         } else if (trueLits > maxToBeUsefull) {
             //The clause is "too far" from current interpretation
             c->incrementFreezeCounter();
             if (c->getFreezeCounter() > 7U || c->getLBD() > medianLBD) {
-                removeLearntClause(c);
+                removeLearntClause(ref);
             } else /* if (c->isAttached()) => always true */ {
-                toDesactivate.push(c);
+                //its watchers will be dropped during the walk over the
+                //watch lists
+                c->setAttached(false);
+                toDesactivate.push(ref);
             }
         } else {
             //This clause could be a usefull clause
@@ -520,19 +679,39 @@ void Solver::reduce() {
     }
 
     unsigned int monowatched = toDesactivate.getSize();
-    for (unsigned int j = 0; j < monowatch.getSize(); j++) {
-        watcher_t* current = monowatch[j];
+    //the frozen clauses that become active again can only be watched once
+    //every watch list has been visited. The same walk drops the watchers of
+    //the clauses that were removed or frozen
+    Array<CRef> toActivate;
+    for (unsigned int j = 0; j < watches.getSize(); j++) {
+        watcher_t* current = watches[j];
         watcher_t* dest = current;
-        watcher_t* end = current + monowatch[j].getSize();
+        watcher_t* end = current + watches[j].getSize();
         while (current != end) {
-            Clause* c = current->watched;
+            if (current->isImplicit()) {
+                *dest = *current;
+                dest++;
+                current++;
+                continue;
+            }
+            if (!current->isFrozen()) {
+                const Clause& cl = arena[current->getRef()];
+                if (cl.isAttached() && isWatching(cl, j)) {
+                    *dest = *current;
+                    dest++;
+                }
+                current++;
+                continue;
+            }
+            CRef ref = current->getRef();
+            Clause* c = &arena[ref];
             ASSERT(!c->isAttached());
             int maxToBeUsefull = (int) ((c->getSize() * deviation));
             int trueLits = 0;
             bool containsProvenLit = reduceClauseEval(c, medianLBD, maxToBeUsefull, trueLits);
 
             if (containsProvenLit) {
-                removeLearntClause(c);
+                removeLearntClause(ref);
                 current++;
             } else if (trueLits > maxToBeUsefull) {
                 c->incrementFreezeCounter();
@@ -541,52 +720,1161 @@ void Solver::reduce() {
                 dest++;
                 current++;
             } else {
-                addWatchedClause(c);
+                toActivate.push(ref);
                 c->setAttached(true);
                 current++;
             }
         }
-        monowatch[j].pop(static_cast<unsigned int>(end - dest));
+        watches[j].pop(static_cast<unsigned int>(end - dest));
+    }
+    releaseRemovedClauses();
+    for (unsigned int j = 0; j < toActivate.getSize(); j++) {
+        addWatchedClause(toActivate[j]);
+    }
+
+    //Deactivate the clause that have to be deactivated
+    while (toDesactivate.getSize() > 0) {
+        CRef ref = toDesactivate.getLast();
+        Clause* c = &arena[ref];
+        ASSERT(!c->isAttached());
+        toDesactivate.pop();
+        watches[c->getLit(0)].push(watcher_t(ref, c->getLit(1), watcher_t::wkFrozen));
+    }
+
+    unsigned int vivified = 0;
+    if (vivification) {
+        vivified = vivifyLearntClauses(medianLBD);
+    }
+
+    phasedElimination();
+
+    if (arena.getWasted() > arena.getSize() * garbageFraction) {
+        garbageCollect();
+    }
+
+    if (verbosity > 0) {
+        ::printf("c %12" PRIu64 " | %10d | %14d | %10d\n",
+                conflicts, learntClauses.getSize(), monowatched, vivified);
+    }
+
+    SATURNIN_END_PROFILE(__profile_reduce);
+}
+
+unsigned int Solver::vivifyLearntClauses(unsigned int maxLBD) {
+    ASSERT_EQUAL(0U, assignLevel);
+    ASSERT_EQUAL(stack.getSize(), propagationHead);
+    uint64_t limit = nbPropag + (uint64_t) ((nbPropag - lastVivifyPropag) * vivifyEffort);
+    Array<CRef> candidates;
+    for (unsigned int i = 0; i < learntClauses.getSize(); i++) {
+        const Clause& c = arena[learntClauses[i]];
+        if (c.isAttached() && !c.isVivified() && c.getLBD() <= maxLBD) {
+            candidates.push(learntClauses[i]);
+        }
+    }
+    std::sort((CRef*) candidates, (CRef*) candidates + candidates.getSize(),
+            [this](CRef a, CRef b) {
+                const Clause& ca = arena[a];
+                const Clause& cb = arena[b];
+                return ca.getLBD() < cb.getLBD() ||
+                        (ca.getLBD() == cb.getLBD() && ca.getSize() < cb.getSize());
+            });
+    //the decisions of the vivification mustn't change the saved phases
+    Array<wbool> savedPhase(phase.getSize());
+    for (unsigned int i = 0; i < phase.getSize(); i++) {
+        savedPhase.push(phase[i]);
+    }
+
+    unsigned int removed = 0;
+    Array<Lit> lits;
+    Array<Lit> simplified;
+    for (unsigned int k = 0; k < candidates.getSize() && nbPropag < limit &&
+            state == wUnknown && !asyncStop; k++) {
+        CRef ref = candidates[k];
+        Clause* c = &arena[ref];
+        c->setVivified(true);
+        //the clause stays watched: it is implied by the other ones, so it
+        //may take part in its own vivification. The propagation may move its
+        //literals, they are copied first
+        lits.pop(lits.getSize());
+        for (unsigned int j = 0; j < c->getSize(); j++) {
+            lits.push(c->getLit(j));
+        }
+        simplified.pop(simplified.getSize());
+        bool satisfied = false;
+        bool stop = false;
+        for (unsigned int j = 0; !stop && j < lits.getSize(); j++) {
+            Lit l = lits[j];
+            wbool value = litValues[l];
+            if (value == wTrue) {
+                //either l was proven or it is implied by the negation of the
+                //previous literals: those literals and l are enough
+                satisfied = varData[VariablesManager::getVar(l)].level == 0;
+                simplified.push(l);
+                stop = true;
+            } else if (value == wUnknown) {
+                simplified.push(l);
+                assignLevel++;
+                stackPointer.push(stack.getSize());
+                enqueue(VariablesManager::oppositeLit(l));
+                //a conflict means that the literals already decided are
+                //enough
+                stop = propagate() != nullptr;
+            }
+            //a false literal is implied false by the previous literals, it
+            //can be removed
+        }
+        if (assignLevel > 0) {
+            backtrack(assignLevel);
+        }
+        //with the chronological backtracking, some literals may have been
+        //implied at level 0
+        if (propagationHead < stack.getSize() && propagate() != nullptr) {
+            state = wFalse;
+        }
+        if (!satisfied && simplified.getSize() == lits.getSize()) {
+            continue;
+        }
+        unsigned int lbd = arena[ref].getLBD();
+        if (!satisfied) {
+            removed += lits.getSize() - simplified.getSize();
+        }
+        //its watchers are dropped once every candidate was vivified
+        removeLearntClause(ref);
+        if (satisfied) {
+            continue;
+        }
+        if (simplified.getSize() < 3) {
+            if (!addClause((const Lit*) simplified, simplified.getSize(), true)) {
+                state = wFalse;
+            }
+            continue;
+        }
+        CRef shorter = addShorterLearntClause(simplified, lbd);
+        arena[shorter].setVivified(true);
+    }
+    cleanWatches();
+    std::memcpy((wbool*) phase, (wbool*) savedPhase, phase.getSize() * sizeof (wbool));
+    lastVivifyPropag = nbPropag;
+    nbVivifiedLits += removed;
+    return removed;
+}
+
+CRef Solver::addShorterLearntClause(const Array<Lit>& lits, unsigned int lbd) {
+    ASSERT(lits.getSize() > 2);
+    CRef shorter = arena.createClause(lits);
+    Clause& sc = arena[shorter];
+    if (lbd > sc.getSize()) {
+        lbd = sc.getSize();
+    }
+    while (lbd >= lbdValues.getSize()) {
+        lbdValues.push(0);
+    }
+    lbdValues[lbd]++;
+    sc.setLBD(lbd);
+    addWatchedClause(shorter);
+    sc.setIndex(learntClauses.getSize());
+    learntClauses.push(shorter);
+#ifdef SATURNIN_DB
+    db.addClause(sc.lits(), db.nbClausesAdded());
+#endif /* SATURNIN_DB */
+    return shorter;
+}
+
+wbool Solver::subsume() {
+    SATURNIN_BEGIN_PROFILE;
+    ASSERT_EQUAL(0U, assignLevel);
+    ASSERT_EQUAL(stack.getSize(), propagationHead);
+    //the frozen learnt clauses are only watched once, they are left aside
+    unsigned int nbInitial = clauses.getSize();
+    Array<CRef> candidates(nbInitial + learntClauses.getSize());
+    for (unsigned int i = 0; i < nbInitial; i++) {
+        candidates.push(clauses[i]);
+    }
+    for (unsigned int i = 0; i < learntClauses.getSize(); i++) {
+        if (arena[learntClauses[i]].isAttached()) {
+            candidates.push(learntClauses[i]);
+        }
+    }
+    //the initial clauses come first among the clauses of a given size so
+    //that they subsume their learnt duplicates
+    std::stable_sort((CRef*) candidates, (CRef*) candidates + candidates.getSize(),
+            [this](CRef a, CRef b) {
+                return arena[a].getSize() < arena[b].getSize();
+            });
+
+    //the occurrence lists keep their entries in the order they were added
+    const unsigned int noEntry = std::numeric_limits<unsigned int>::max();
+    Array<SubsumeEntry> entries(candidates.getSize() + 1);
+    Array<unsigned int> firstEntry(watches.getSize());
+    Array<unsigned int> lastEntry(watches.getSize());
+    Array<unsigned int> nbEntries(watches.getSize());
+    for (unsigned int i = 0; i < watches.getSize(); i++) {
+        firstEntry.push(noEntry);
+        lastEntry.push(noEntry);
+        nbEntries.push(0);
+    }
+    auto addEntry = [&](Lit l, uint64_t sig, CRef r, bool learnt) {
+        SubsumeEntry e;
+        e.signature = sig;
+        e.ref = r;
+        e.next = noEntry;
+        e.learnt = learnt;
+        unsigned int pos = entries.getSize();
+        entries.push(e);
+        if (lastEntry[l] == noEntry) {
+            firstEntry[l] = pos;
+        } else {
+            entries[lastEntry[l]].next = pos;
+        }
+        lastEntry[l] = pos;
+        nbEntries[l]++;
+    };
+    Array<bool> marks(watches.getSize());
+    for (unsigned int i = 0; i < watches.getSize(); i++) {
+        marks.push(false);
+    }
+    //the initial clauses removed, to update clauses at the end
+    Array<CRef> removedInitial;
+
+    int64_t budget = subsumeBudget;
+    Array<Lit> lits;
+    for (unsigned int k = 0; k < candidates.getSize() && budget > 0 &&
+            state == wUnknown && !asyncStop; k++) {
+        CRef ref = candidates[k];
+        const Clause& c = arena[ref];
+        bool learnt = c.isLearnt();
+        //the clauses containing a proven literal are left to simplify
+        bool assigned = false;
+        lits.pop(lits.getSize());
+        uint64_t signature = 0;
+        for (unsigned int i = 0; !assigned && i < c.getSize(); i++) {
+            Lit l = c.getLit(i);
+            assigned = litValues[l] != wUnknown;
+            lits.push(l);
+            marks[l] = true;
+            signature |= 1ULL << (VariablesManager::getVar(l) & 63);
+        }
+        if (assigned) {
+            for (unsigned int i = 0; i < lits.getSize(); i++) {
+                marks[lits[i]] = false;
+            }
+            continue;
+        }
+
+        bool subsumed = false;
+        bool strengthened = false;
+        bool changed = true;
+        while (changed && !subsumed) {
+            changed = false;
+            //the literal of c that can be removed
+            Lit toRemove = lit_Undef;
+            for (unsigned int i = 0; toRemove == lit_Undef && !subsumed && i < lits.getSize(); i++) {
+                Lit l = lits[i];
+                //the binary clauses are at the beginning of the watch lists
+                const Array<watcher_t>& ws = watches[l];
+                for (unsigned int j = 0; toRemove == lit_Undef && !subsumed &&
+                        j < ws.getSize() && ws[j].isBinary(); j++) {
+                    budget--;
+                    Lit other = ws[j].block;
+                    if (marks[other]) {
+                        subsumed = true;
+                    } else if (marks[VariablesManager::oppositeLit(other)]) {
+                        toRemove = VariablesManager::oppositeLit(other);
+                    }
+                }
+                for (unsigned int side = 0; side < 2 && toRemove == lit_Undef && !subsumed; side++) {
+                    Lit occ = side == 0 ? l : VariablesManager::oppositeLit(l);
+                    for (unsigned int j = firstEntry[occ]; toRemove == lit_Undef && !subsumed &&
+                            j != noEntry; j = entries[j].next) {
+                        const SubsumeEntry& e = entries[j];
+                        budget--;
+                        if ((e.signature & ~signature) != 0) {
+                            continue;
+                        }
+                        const Clause& d = arena[e.ref];
+                        //the literal of c whose opposite is in d
+                        Lit flipped = lit_Undef;
+                        bool included = true;
+                        for (unsigned int m = 0; included && m < d.getSize(); m++) {
+                            Lit dl = d.getLit(m);
+                            budget--;
+                            if (!marks[dl]) {
+                                if (flipped == lit_Undef && marks[VariablesManager::oppositeLit(dl)]) {
+                                    flipped = VariablesManager::oppositeLit(dl);
+                                } else {
+                                    included = false;
+                                }
+                            }
+                        }
+                        if (!included) {
+                            continue;
+                        }
+                        if (flipped != lit_Undef) {
+                            toRemove = flipped;
+                        } else if (learnt || !e.learnt) {
+                            subsumed = true;
+                        }
+                    }
+                }
+            }
+            if (!subsumed && toRemove != lit_Undef) {
+                //self-subsuming resolution: c without toRemove is implied
+                marks[toRemove] = false;
+                unsigned int pos = 0;
+                while (lits[pos] != toRemove) {
+                    pos++;
+                }
+                lits[pos] = lits.getLast();
+                lits.pop();
+                signature = 0;
+                for (unsigned int i = 0; i < lits.getSize(); i++) {
+                    signature |= 1ULL << (VariablesManager::getVar(lits[i]) & 63);
+                }
+                strengthened = true;
+                changed = true;
+            }
+        }
+        for (unsigned int i = 0; i < lits.getSize(); i++) {
+            marks[lits[i]] = false;
+        }
+
+        if (!subsumed && !strengthened) {
+            //c can now subsume the next clauses, it is watched by its
+            //literal having the fewest occurrences
+            Lit best = lits[0];
+            for (unsigned int i = 1; i < lits.getSize(); i++) {
+                if (nbEntries[lits[i]] < nbEntries[best]) {
+                    best = lits[i];
+                }
+            }
+            addEntry(best, signature, ref, learnt);
+            continue;
+        }
+
+        if (subsumed) {
+            nbSubsumedClauses++;
+        } else {
+            nbStrengthenedClauses++;
+        }
+        //remove c, the strengthened clause replaces it
+        unsigned int lbd = c.getLBD();
+        if (learnt) {
+            removeLearntClause(ref);
+        } else {
+            removeClause(ref);
+            removedInitial.push(ref);
+        }
+        if (subsumed) {
+            continue;
+        }
+        CRef shorter = CRef_Undef;
+        if (learnt && lits.getSize() > 2) {
+            shorter = addShorterLearntClause(lits, lbd);
+        } else {
+            //the learnt binary clauses are kept forever, like the initial ones
+            unsigned int nbClauses = clauses.getSize();
+            if (!addClause((const Lit*) lits, lits.getSize(), true)) {
+                state = wFalse;
+            } else if (clauses.getSize() > nbClauses) {
+                shorter = clauses.getLast();
+            }
+        }
+        if (shorter != CRef_Undef) {
+            const Clause& sc = arena[shorter];
+            Lit best = sc.getLit(0);
+            signature = 0;
+            for (unsigned int i = 0; i < sc.getSize(); i++) {
+                signature |= 1ULL << (VariablesManager::getVar(sc.getLit(i)) & 63);
+                if (nbEntries[sc.getLit(i)] < nbEntries[best]) {
+                    best = sc.getLit(i);
+                }
+            }
+            addEntry(best, signature, shorter, sc.isLearnt());
+        }
+    }
+
+    if (removedInitial.getSize() > 0) {
+        std::sort((CRef*) removedInitial, (CRef*) removedInitial + removedInitial.getSize());
+        unsigned int j = 0;
+        for (unsigned int i = 0; i < clauses.getSize(); i++) {
+            if (!std::binary_search((CRef*) removedInitial,
+                    (CRef*) removedInitial + removedInitial.getSize(), clauses[i])) {
+                clauses[j++] = clauses[i];
+            }
+        }
+        clauses.pop(clauses.getSize() - j);
+    }
+    cleanWatches();
+    SATURNIN_END_PROFILE(__profile_subsume);
+    return state;
+}
+
+wbool Solver::probe() {
+    SATURNIN_BEGIN_PROFILE;
+    ASSERT_EQUAL(0U, assignLevel);
+    ASSERT_EQUAL(stack.getSize(), propagationHead);
+    uint64_t limit = nbPropag + probeBudget;
+    //the decisions of the probing mustn't change the saved phases
+    Array<wbool> savedPhase(phase.getSize());
+    for (unsigned int i = 0; i < phase.getSize(); i++) {
+        savedPhase.push(phase[i]);
+    }
+    Array<bool> marks(watches.getSize());
+    //the literals implied by pos through binary clauses only
+    Array<bool> binaryMarks(watches.getSize());
+    for (unsigned int i = 0; i < watches.getSize(); i++) {
+        marks.push(false);
+        binaryMarks.push(false);
+    }
+    //the tree of the implications of the probed literal
+    Array<ProbeNode> tree(nbVar);
+    for (Var v = 0; v < nbVar; v++) {
+        tree.push(ProbeNode());
+    }
+    Array<Lit> positive;
+    Array<Lit> negative;
+    Array<Lit> units;
+    Array<Lit> equivalent;
+    Array<Lit> resolvents;
+    for (unsigned int k = 0; k < nbVar && nbPropag < limit && state == wUnknown && !asyncStop; k++) {
+        Var v = nextProbeVar;
+        nextProbeVar = nextProbeVar + 1 < nbVar ? nextProbeVar + 1 : 0;
+        if (assign[v] != wUnknown) {
+            continue;
+        }
+        //a literal implies another one through a binary clause if its
+        //opposite has a binary watcher, they are at the beginning of the
+        //watch lists
+        Lit pos = VariablesManager::getLit(v, true);
+        Lit neg = VariablesManager::oppositeLit(pos);
+        bool posImplies = watches[neg].getSize() > 0 && watches[neg][0].isBinary();
+        bool negImplies = watches[pos].getSize() > 0 && watches[pos][0].isBinary();
+        if (!posImplies && !negImplies) {
+            continue;
+        }
+        //for a root, the other literal propagates nothing
+        Lit first = posImplies ? pos : neg;
+        if (!probeLiteral(first, positive, resolvents, tree)) {
+            nbFailedLiterals++;
+            Lit unit = VariablesManager::oppositeLit(first);
+            if (!addClause(&unit, 1, true)) {
+                state = wFalse;
+            }
+            continue;
+        }
+        addHyperBinaryResolvents(resolvents);
+        if (!posImplies || !negImplies || state != wUnknown) {
+            continue;
+        }
+        for (unsigned int i = 0; i < positive.getSize(); i++) {
+            binaryMarks[positive[i]] = tree[VariablesManager::getVar(positive[i])].binary;
+        }
+        if (!probeLiteral(neg, negative, resolvents, tree)) {
+            for (unsigned int i = 0; i < positive.getSize(); i++) {
+                binaryMarks[positive[i]] = false;
+            }
+            nbFailedLiterals++;
+            if (!addClause(&pos, 1, true)) {
+                state = wFalse;
+            }
+            continue;
+        }
+        addHyperBinaryResolvents(resolvents);
+        for (unsigned int i = 0; i < positive.getSize(); i++) {
+            marks[positive[i]] = true;
+        }
+        units.pop(units.getSize());
+        equivalent.pop(equivalent.getSize());
+        for (unsigned int i = 0; i < negative.getSize(); i++) {
+            Lit m = negative[i];
+            if (marks[m]) {
+                units.push(m);
+            } else if (marks[VariablesManager::oppositeLit(m)] &&
+                    (!binaryMarks[VariablesManager::oppositeLit(m)] ||
+                    !tree[VariablesManager::getVar(m)].binary)) {
+                //pos implies -m and neg implies m, one of them through a
+                //longer clause as the binary implications are already
+                //handled by the substitution of the equivalent literals
+                equivalent.push(m);
+            }
+        }
+        for (unsigned int i = 0; i < positive.getSize(); i++) {
+            marks[positive[i]] = false;
+            binaryMarks[positive[i]] = false;
+        }
+        for (unsigned int i = 0; i < units.getSize() && state == wUnknown; i++) {
+            if (litValues[units[i]] == wUnknown) {
+                nbProbedUnits++;
+                if (!addClause(&units[i], 1, true)) {
+                    state = wFalse;
+                }
+            }
+        }
+        for (unsigned int i = 0; i < equivalent.getSize() && state == wUnknown; i++) {
+            Lit m = equivalent[i];
+            if (assign[v] != wUnknown || litValues[m] != wUnknown) {
+                continue;
+            }
+            Lit c[2] = {pos, m};
+            bool added = false;
+            if (!hasBinaryClause(pos, m)) {
+                addClause(c, 2, true);
+                added = true;
+            }
+            c[0] = neg;
+            c[1] = VariablesManager::oppositeLit(m);
+            if (!hasBinaryClause(c[0], c[1])) {
+                addClause(c, 2, true);
+                added = true;
+            }
+            if (added) {
+                nbProbedEquivalences++;
+            }
+        }
+    }
+    std::memcpy((wbool*) phase, (wbool*) savedPhase, phase.getSize() * sizeof (wbool));
+    SATURNIN_END_PROFILE(__profile_probe);
+    return state;
+}
+
+bool Solver::probeLiteral(Lit l, Array<Lit>& implied, Array<Lit>& resolvents, Array<ProbeNode>& tree) {
+    implied.pop(implied.getSize());
+    resolvents.pop(resolvents.getSize());
+    unsigned int start = stack.getSize();
+    assignLevel++;
+    stackPointer.push(start);
+    enqueue(l);
+    bool ok = propagate() == nullptr;
+    if (ok) {
+        ProbeNode& root = tree[VariablesManager::getVar(l)];
+        root.parent = lit_Undef;
+        root.depth = 0;
+        root.binary = true;
+        for (unsigned int i = start + 1; i < stack.getSize(); i++) {
+            Lit m = stack[i];
+            implied.push(m);
+            //the literals of the reason that were implied by l, the others
+            //were proven
+            Lit* reason = getReason(VariablesManager::getVar(m));
+            Lit dominator = lit_Undef;
+            unsigned int nbImplying = 0;
+            unsigned int j = 1;
+            for (; reason[j] != lit_Undef; j++) {
+                Lit t = VariablesManager::oppositeLit(reason[j]);
+                if (varData[VariablesManager::getVar(t)].level == 0) {
+                    continue;
+                }
+                nbImplying++;
+                if (dominator == lit_Undef) {
+                    dominator = t;
+                    continue;
+                }
+                //the closest common ancestor in the tree of the implications
+                while (dominator != t) {
+                    const ProbeNode& nd = tree[VariablesManager::getVar(dominator)];
+                    const ProbeNode& nt = tree[VariablesManager::getVar(t)];
+                    if (nd.depth >= nt.depth) {
+                        dominator = nd.parent;
+                    }
+                    if (nt.depth >= nd.depth) {
+                        t = nt.parent;
+                    }
+                }
+            }
+            ASSERT(dominator != lit_Undef);
+            if (nbImplying > 1) {
+                //the dominator implies m: -dominator m is a hyper-binary
+                //resolvent. It is only kept if it subsumes the reason, the
+                //others would mostly slow down the propagation
+                Lit resolvent = VariablesManager::oppositeLit(dominator);
+                bool subsumes = false;
+                for (unsigned int k = 1; k < j && !subsumes; k++) {
+                    subsumes = reason[k] == resolvent;
+                }
+                if (subsumes) {
+                    resolvents.push(resolvent);
+                    resolvents.push(m);
+                }
+            }
+            const ProbeNode& nd = tree[VariablesManager::getVar(dominator)];
+            ProbeNode& node = tree[VariablesManager::getVar(m)];
+            node.parent = dominator;
+            node.depth = nd.depth + 1;
+            //the implication is made of binary clauses only
+            node.binary = reason[2] == lit_Undef && nd.binary;
+        }
+    }
+    backtrack(assignLevel);
+    ASSERT_EQUAL(stack.getSize(), propagationHead);
+    return ok;
+}
+
+void Solver::addHyperBinaryResolvents(const Array<Lit>& resolvents) {
+    for (unsigned int i = 0; i < resolvents.getSize() && state == wUnknown; i += 2) {
+        Lit c[2] = {resolvents[i], resolvents[i + 1]};
+        if (hasBinaryClause(c[0], c[1])) {
+            continue;
+        }
+        nbHyperBinaries++;
+        if (!addClause(c, 2, true)) {
+            state = wFalse;
+        }
+    }
+}
+
+wbool Solver::reduceTransitive() {
+    SATURNIN_BEGIN_PROFILE;
+    ASSERT_EQUAL(0U, assignLevel);
+    ASSERT_EQUAL(stack.getSize(), propagationHead);
+    Array<unsigned int> stamps(watches.getSize());
+    for (unsigned int i = 0; i < watches.getSize(); i++) {
+        stamps.push(0U);
+    }
+    unsigned int stamp = 0;
+    Array<Lit> toVisit;
+    int64_t budget = transitiveBudget;
+    for (unsigned int k = 0; k < watches.getSize() && budget > 0 && state == wUnknown && !asyncStop; k++) {
+        Lit a = nextTransitiveLit;
+        nextTransitiveLit = nextTransitiveLit + 1 < watches.getSize() ? nextTransitiveLit + 1 : 0;
+        if (litValues[a] != wUnknown) {
+            continue;
+        }
+        //the binary clause a b is the implication -a -> b, it is transitive
+        //if b can be reached from -a through other binary clauses
+        Lit src = VariablesManager::oppositeLit(a);
+        unsigned int j = 0;
+        while (j < watches[a].getSize() && watches[a][j].isBinary() && budget > 0) {
+            Lit b = watches[a][j].block;
+            //each clause is checked from its smallest literal
+            if (b < a || litValues[b] != wUnknown) {
+                j++;
+                continue;
+            }
+            stamp++;
+            stamps[src] = stamp;
+            toVisit.pop(toVisit.getSize());
+            toVisit.push(src);
+            bool reached = false;
+            bool failed = false;
+            for (unsigned int n = 0; n < toVisit.getSize() && !reached && !failed; n++) {
+                //the literals implied by x are the other literals of the
+                //binary clauses of -x
+                const Array<watcher_t>& ws = watches[VariablesManager::oppositeLit(toVisit[n])];
+                for (unsigned int w = 0; w < ws.getSize() && ws[w].isBinary() && !reached; w++) {
+                    budget--;
+                    Lit y = ws[w].block;
+                    if (n == 0 && y == b) {
+                        //the clause itself
+                        continue;
+                    }
+                    if (y == b) {
+                        reached = true;
+                    } else if (y == a) {
+                        //-a implies a
+                        failed = true;
+                    } else if (stamps[y] != stamp) {
+                        stamps[y] = stamp;
+                        toVisit.push(y);
+                    }
+                }
+            }
+            if (failed) {
+                nbFailedLiterals++;
+                if (!addClause(&a, 1, true)) {
+                    state = wFalse;
+                }
+                break;
+            }
+            if (reached) {
+                //the last binary watcher of a, not checked yet, takes its place
+                removeBinaryClause(a, b);
+                nbTransitiveBinaries++;
+            } else {
+                j++;
+            }
+        }
+    }
+    SATURNIN_END_PROFILE(__profile_probe);
+    return state;
+}
+
+void Solver::removeBinaryClause(Lit a, Lit b) {
+    const Lit lits[2] = {a, b};
+    for (unsigned int i = 0; i < 2; i++) {
+        Array<watcher_t>& ws = watches[lits[i]];
+        unsigned int pos = 0;
+        while (!(ws[pos].isBinary() && ws[pos].block == lits[1 - i])) {
+            pos++;
+        }
+        //the binary watchers must stay at the beginning of the list: the
+        //last binary watcher takes the place of the removed one, and the last
+        //watcher takes its own
+        unsigned int lastBinary = pos;
+        while (lastBinary + 1 < ws.getSize() && ws[lastBinary + 1].isBinary()) {
+            lastBinary++;
+        }
+        ws[pos] = ws[lastBinary];
+        ws[lastBinary] = ws.getLast();
+        ws.pop();
+    }
+    ASSERT(nbBin > 0);
+    nbBin--;
+}
+
+bool Solver::hasBinaryClause(Lit a, Lit b) const {
+    const Array<watcher_t>& ws = watches.get(a);
+    for (unsigned int i = 0; i < ws.getSize() && ws.get(i).isBinary(); i++) {
+        if (ws.get(i).block == b) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Solver::garbageCollect() {
+    ASSERT_EQUAL(0U, assignLevel);
+    nbGarbageCollect++;
+    ClauseArena to(arena.getSize() - arena.getWasted());
+
+    //first, follow the watch lists
+    for (unsigned int i = 0; i < watches.getSize(); i++) {
+        watcher_t* w = watches[i];
+        watcher_t* end = w + watches[i].getSize();
+        for (; w != end; w++) {
+            if (!w->isImplicit()) {
+                CRef ref = w->getRef();
+                arena.relocate(ref, to);
+                w->setRef(ref);
+            }
+        }
+    }
+
+    //At level 0, the reasons are never looked at during the analysis, and the
+    //clause they refer to may already have been removed
+    for (unsigned int i = 0; i < varData.getSize(); i++) {
+        if (varData[i].reason != binaryReason) {
+            varData[i].reason = CRef_Undef;
+        }
+    }
+
+    //every clause but the ternary ones is watched, therefore those are
+    //mostly retrieving the new references
+    for (unsigned int i = 0; i < clauses.getSize(); i++) {
+        arena.relocate(clauses[i], to);
+    }
+    for (unsigned int i = 0; i < learntClauses.getSize(); i++) {
+        arena.relocate(learntClauses[i], to);
+    }
+
+    ASSERT_EQUAL(arena.getNbClauses(), to.getNbClauses());
+    to.moveTo(arena);
+}
+
+void Solver::updateVSIDS(Var v) {
+
+    varActivityValue[v] += vsidsInc;
+    if (varActivityValue[v] > 1e100) {
+        for (unsigned int i = 0; i < varActivityValue.getSize(); i++) {
+            varActivityValue[i] *= 1e-100;
+        }
+        vsidsInc *= 1e-100;
+        //the heap keeps a copy of the activities
+        varActivity.rebuild();
+    }
+    if (varActivity.contains(v)) {
+        varActivity.updateValue(v);
+    }
+}
+
+void Solver::setBranchingHeuristic(BranchingHeuristic h) {
+    if (h == branching) {
+        return;
+    }
+    bool fromVMTF = branching == BranchingHeuristic::VMTF;
+    branching = h;
+    if (h == BranchingHeuristic::VMTF) {
+        //nothing is known about the variables after vmtfSearch anymore
+        vmtfSearch = vmtfLast;
+        return;
+    }
+    if (fromVMTF) {
+        //the unassigned variables may have left the heap
+        for (Var v = 0; v < assign.getSize(); v++) {
+            if (assign[v] == wUnknown && !varActivity.contains(v)) {
+                varActivity.add(v);
+            }
+        }
+    }
+    if (h == BranchingHeuristic::LRB) {
+        //the learning rates start from the current activities
+        for (Var v = 0; v < lrbData.getSize(); v++) {
+            lrbData[v].assigned = conflicts;
+            lrbData[v].unassigned = conflicts;
+            lrbData[v].participated = 0;
+            lrbData[v].reasoned = 0;
+        }
+    }
+}
+
+Var Solver::pickBranchVar() {
+    if (branching == BranchingHeuristic::VMTF) {
+        Var v = vmtfSearch;
+        while (v != var_Undef && assign[v] != wUnknown) {
+            v = vmtfLinks[v].prev;
+        }
+        if (v != var_Undef) {
+            vmtfSearch = v;
+        }
+        return v;
+    }
+    while (varActivity.getSize() > 0) {
+        Var v = varActivity.getMin();
+        if (assign[v] != wUnknown) {
+            varActivity.removeMin();
+        } else if (branching != BranchingHeuristic::LRB || !lrbDecay(v)) {
+            //with LRB, the top of the heap is only valid once its decay
+            //has been applied
+            return varActivity.removeMin();
+        }
+    }
+    return var_Undef;
+}
+
+void Solver::vmtfAppend(Var v) {
+    VmtfLink& link = vmtfLinks[v];
+    link.prev = vmtfLast;
+    link.next = var_Undef;
+    link.stamp = ++vmtfStamp;
+    if (vmtfLast == var_Undef) {
+        vmtfFirst = v;
+    } else {
+        vmtfLinks[vmtfLast].next = v;
+    }
+    vmtfLast = v;
+    if (assign[v] == wUnknown) {
+        vmtfSearch = v;
+    }
+}
+
+void Solver::vmtfFlushBumps() {
+    //the oldest variables are moved first to keep their relative order
+    std::sort((Var*) vmtfBumped, (Var*) vmtfBumped + vmtfBumped.getSize(),
+            [this](Var a, Var b) {
+                return vmtfLinks[a].stamp < vmtfLinks[b].stamp;
+            });
+    for (unsigned int i = 0; i < vmtfBumped.getSize(); i++) {
+        Var v = vmtfBumped[i];
+        if (v == vmtfLast) {
+            vmtfLinks[v].stamp = ++vmtfStamp;
+            continue;
+        }
+        //unlink v
+        VmtfLink& link = vmtfLinks[v];
+        if (link.prev == var_Undef) {
+            vmtfFirst = link.next;
+        } else {
+            vmtfLinks[link.prev].next = link.next;
+        }
+        vmtfLinks[link.next].prev = link.prev;
+        if (vmtfSearch == v) {
+            //every variable after v is assigned, so is v
+            vmtfSearch = link.next;
+        }
+        vmtfAppend(v);
+    }
+    vmtfBumped.pop(vmtfBumped.getSize());
+}
+
+void Solver::lrbAssign(Var v) {
+    LrbData& data = lrbData[v];
+    if (data.unassigned != conflicts) {
+        //the heap keeps its copy of the value until v is unassigned
+        varActivityValue[v] *= getLrbDecay(conflicts - data.unassigned);
+    }
+    data.assigned = conflicts;
+    data.participated = 0;
+    data.reasoned = 0;
+}
+
+void Solver::lrbUnassign(Var v) {
+    LrbData& data = lrbData[v];
+    uint64_t interval = conflicts - data.assigned;
+    if (interval > 0) {
+        double rate = (double) (data.participated + data.reasoned) / (double) interval;
+        varActivityValue[v] = (1 - lrbStep) * varActivityValue[v] + lrbStep * rate;
+        if (varActivity.contains(v)) {
+            varActivity.updateValue(v);
+        }
+    }
+    data.unassigned = conflicts;
+}
+
+bool Solver::lrbDecay(Var v) {
+    uint64_t age = conflicts - lrbData[v].unassigned;
+    if (age == 0) {
+        return false;
+    }
+    varActivityValue[v] *= getLrbDecay(age);
+    lrbData[v].unassigned = conflicts;
+    if (varActivity.contains(v)) {
+        varActivity.updateValue(v);
+    }
+    return true;
+}
+
+bool Solver::addClause(const Array<Lit>& c) {
+    return addClause((const Lit*) c, c.getSize());
+}
+
+bool Solver::addClauses(const Array<Array<Lit> >& batch, bool mapped) {
+    ASSERT_EQUAL((unsigned int) 0, assignLevel);
+    ASSERT_EQUAL(1U, stackPointer.getSize());
+    if (state == wTrue) {
+        state = wUnknown;
+        model.pop(model.getSize());
+    }
+#ifdef SATURNIN_DB
+    mapped = mapped || db.isInitialized();
+#endif
+    unsigned int nbClauses = batch.getSize();
+    unsigned int nbLits = 0;
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        ASSERT(batch.get(i).getSize() != 0);
+        nbLits += batch.get(i).getSize();
+    }
+    //the literals of the clauses, one after the other
+    Array<Lit> lits(nbLits + 1);
+    Array<unsigned int> starts(nbClauses + 1);
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        starts.push(lits.getSize());
+        const Array<Lit>& c = batch.get(i);
+        for (unsigned int j = 0; j < c.getSize(); j++) {
+            Lit l = mapped ? c.get(j) : mapLit(c.get(j));
+            ensureCapacity(VariablesManager::getVar(l), nbVar);
+            lits.push(l);
+        }
+    }
+    starts.push(lits.getSize());
+
+    //sort the literals of each clause
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        sortLits((Lit*) lits + starts[i], starts[i + 1] - starts[i]);
+    }
+
+    //remove the duplicated literals, the false ones and the satisfied
+    //clauses in a single pass against the values of level 0. The literals of
+    //a clause are sorted, therefore l and ¬l are next to each other. A unit
+    //is assigned right away for the next clauses, the clauses already kept
+    //are simplified by its propagation once they are watched
+    Array<unsigned int> sizes(nbClauses + 1);
+    Array<unsigned int> kept(nbClauses + 1);
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        Lit* c = (Lit*) lits + starts[i];
+        unsigned int sz = 0;
+        bool satisfied = false;
+        for (unsigned int j = starts[i]; !satisfied && j < starts[i + 1]; j++) {
+            Lit l = lits[j];
+            if (litValues[l] == wTrue) {
+                satisfied = true;
+            } else if (sz > 0 && c[sz - 1] == VariablesManager::oppositeLit(l)) {
+                satisfied = true;
+            } else if (litValues[l] == wUnknown && (sz == 0 || c[sz - 1] != l)) {
+                c[sz++] = l;
+            }
+        }
+        sizes.push(sz);
+        if (satisfied) {
+            continue;
+        }
+        if (sz == 1 && assignUnit(c[0])) {
+            continue;
+        }
+        if (sz <= 1) {
+            //the units already assigned are propagated to leave the trail
+            //as addClause would
+            propagateUnits();
+            state = wFalse;
+            return false;
+        }
+        kept.push(i);
+    }
+
+    //drop the duplicated clauses, found through a hash of their literals
+    unsigned int tableSize = 2;
+    while (tableSize < kept.getSize() * 2) {
+        tableSize *= 2;
+    }
+    Array<unsigned int> table(tableSize);
+    for (unsigned int i = 0; i < tableSize; i++) {
+        table.push(std::numeric_limits<unsigned int>::max());
+    }
+    unsigned int nbKept = 0;
+    for (unsigned int k = 0; k < kept.getSize(); k++) {
+        unsigned int i = kept[k];
+        const Lit* c = (const Lit*) lits + starts[i];
+        uint64_t hash = sizes[i];
+        for (unsigned int j = 0; j < sizes[i]; j++) {
+            hash = (hash ^ c[j]) * 0x100000001B3ULL;
+        }
+        unsigned int h = (unsigned int) (hash ^ (hash >> 32)) & (tableSize - 1);
+        bool duplicate = false;
+        while (!duplicate && table[h] != std::numeric_limits<unsigned int>::max()) {
+            unsigned int other = table[h];
+            duplicate = sizes[other] == sizes[i] &&
+                    memcmp(c, (const Lit*) lits + starts[other], sizes[i] * sizeof (Lit)) == 0;
+            h = (h + 1) & (tableSize - 1);
+        }
+        if (!duplicate) {
+            table[h] = i;
+            kept[nbKept++] = i;
+        }
+    }
+    kept.pop(kept.getSize() - nbKept);
+
+    //count the watchers of each literal to allocate the lists once
+    Array<unsigned int> nbWatchers(nbVar * 2);
+    for (unsigned int i = 0; i < nbVar * 2; i++) {
+        nbWatchers.push(0);
+    }
+    unsigned int nbLong = 0;
+    for (unsigned int k = 0; k < kept.getSize(); k++) {
+        unsigned int i = kept[k];
+        const Lit* c = (const Lit*) lits + starts[i];
+        nbWatchers[c[0]]++;
+        nbWatchers[c[1]]++;
+        if (sizes[i] == 3) {
+            nbWatchers[c[2]]++;
+        }
+        if (sizes[i] > 2) {
+            nbLong++;
+        }
+    }
+    for (Lit l = 0; l < nbVar * 2; l++) {
+        watches[l].reserve(watches[l].getSize() + nbWatchers[l]);
+    }
+    clauses.reserve(clauses.getSize() + nbLong);
+
+    //the binary watchers are added first to stay in front of the others
+    for (unsigned int k = 0; k < kept.getSize(); k++) {
+        unsigned int i = kept[k];
+        if (sizes[i] != 2) {
+            continue;
+        }
+        const Lit* c = (const Lit*) lits + starts[i];
+        addBinaryWatch(c[0], c[1]);
+#ifdef SATURNIN_DB
+        Lit clDB[3];
+        clDB[0] = c[0];
+        clDB[1] = c[1];
+        clDB[2] = std::numeric_limits<Lit>::max();
+        db.addClause(clDB, db.nbClausesAdded());
+#endif /* SATURNIN_DB */
+        nbBin++;
+    }
+    for (unsigned int k = 0; k < kept.getSize(); k++) {
+        unsigned int i = kept[k];
+        if (sizes[i] == 2) {
+            continue;
+        }
+        CRef newClause = arena.createClause((const Lit*) lits + starts[i], sizes[i]);
+        addWatchedClause(newClause);
+        clauses.push(newClause);
+#ifdef SATURNIN_DB
+        db.addClause(arena[newClause].lits(), db.nbClausesAdded());
+#endif /* SATURNIN_DB */
     }
+    return propagateUnits();
+}
 
-    //Deactivate the clause that have to be deactivated
-    while (toDesactivate.getSize() > 0) {
-        Clause* c = toDesactivate.getLast();
-        ASSERT(c->isAttached());
-        toDesactivate.pop();
-        c->setAttached(false);
-        stopWatchClause(c->getLit(0), c);
-        stopWatchClause(c->getLit(1), c);
-        monowatch[c->getLit(0)].push(watcher_t(c, c->getLit(1)));
+void Solver::addEliminatedClause(const Lit * const literals, unsigned int sz) {
+    ASSERT(sz != 0);
+    for (unsigned int i = 0; i < sz; i++) {
+        ensureCapacity(VariablesManager::getVar(literals[i]), nbVar);
+        extensionStack.push(literals[i]);
     }
+    extensionStack.push(sz);
+}
 
-    phasedElimination();
-    allocator.clearup();
-
-    if (verbosity > 0) {
-        ::printf("c %12" PRIu64 " | %10d | %14d\n",
-                conflicts, learntClauses.getSize(), monowatched);
+void Solver::extendModel() {
+    ASSERT(state == wTrue);
+    model.pop(model.getSize());
+    for (Var v = 0; v < map.getSize(); v++) {
+        //the variables that aren't used may take any value
+        model.push(map[v] != var_Undef && assign[map[v]] == wTrue ? wTrue : wFalse);
+    }
+    //a removed clause is satisfied by flipping its eliminated variable,
+    //starting from the last one removed
+    unsigned int pos = extensionStack.getSize();
+    while (pos > 0) {
+        unsigned int sz = extensionStack[pos - 1];
+        ASSERT(pos > sz);
+        pos -= sz + 1;
+        bool satisfied = false;
+        for (unsigned int i = pos; !satisfied && i < pos + sz; i++) {
+            Lit l = extensionStack[i];
+            satisfied = model[VariablesManager::getVar(l)] ==
+                    (VariablesManager::getLitSign(l) ? wTrue : wFalse);
+        }
+        if (!satisfied) {
+            Lit l = extensionStack[pos];
+            model[VariablesManager::getVar(l)] = VariablesManager::getLitSign(l) ? wTrue : wFalse;
+        }
     }
-
-    SATURNIN_END_PROFILE(__profile_reduce);
 }
 
-void Solver::updateVSIDS(Var v) {
-
-    varActivityValue[v] += vsidsInc;
-    if (varActivityValue[v] > 1e100) {
-        for (unsigned int i = 0; i < varActivityValue.getSize(); i++) {
-            varActivityValue[i] *= 1e-100;
+void Solver::sortLits(Lit* lits, unsigned int sz) {
+    if (sz <= 16) {
+        for (unsigned int i = 1; i < sz; i++) {
+            Lit l = lits[i];
+            unsigned int j = i;
+            while (j > 0 && lits[j - 1] > l) {
+                lits[j] = lits[j - 1];
+                j--;
+            }
+            lits[j] = l;
         }
-        vsidsInc *= 1e-100;
+        return;
     }
-    if (varActivity.contains(v)) {
-        varActivity.updateValue(v);
+    //least significant byte first, skipping the bytes equal for all literals
+    ArrayHelper<Lit> buffer(sz);
+    Lit* from = lits;
+    Lit* to = (Lit*) buffer;
+    Lit diff = 0;
+    for (unsigned int i = 1; i < sz; i++) {
+        diff |= lits[i] ^ lits[0];
+    }
+    for (unsigned int shift = 0; shift < sizeof (Lit) * 8; shift += 8) {
+        if (((diff >> shift) & 0xFF) == 0) {
+            continue;
+        }
+        unsigned int count[257] = {0};
+        for (unsigned int i = 0; i < sz; i++) {
+            count[((from[i] >> shift) & 0xFF) + 1]++;
+        }
+        for (unsigned int i = 1; i < 257; i++) {
+            count[i] += count[i - 1];
+        }
+        for (unsigned int i = 0; i < sz; i++) {
+            to[count[(from[i] >> shift) & 0xFF]++] = from[i];
+        }
+        Lit* tmp = from;
+        from = to;
+        to = tmp;
+    }
+    if (from != lits) {
+        memcpy(lits, from, sz * sizeof (Lit));
     }
 }
 
-bool Solver::addClause(const Array<Lit>& c) {
-    return addClause((const Lit*) c, c.getSize());
+Lit Solver::mapLit(Lit l) {
+    Var v = VariablesManager::getVar(l);
+    ensureCapacity(v, nbVar);
+    if (map[v] == var_Undef) {
+        map[v] = nextVarMap;
+        revertMap[nextVarMap] = v;
+        nextVarMap++;
+    }
+    return VariablesManager::getLit(map[v], VariablesManager::getLitSign(l));
 }
 
 void Solver::ensureCapacity(Var v, unsigned int nbInitialized) {
@@ -600,13 +1888,20 @@ void Solver::ensureCapacity(Var v, unsigned int nbInitialized) {
 #endif /* SATURNIN_PARALLEL */
     nbInitialized);
     unsigned int nbVarsToAdd = v + 1 - assign.getSize();
+    //the padding stays after the value of the last literal
+    if (litValues.getSize() > 0) {
+        litValues.pop(LiteralSearch::padding);
+    }
     for (unsigned int i = 0; i < nbVarsToAdd; i++) {
         map.push(var_Undef);
         revertMap.push(var_Undef);
         binReasons.push(assign.getSize());
         binReasons.push(lit_Undef);
         binReasons.push(lit_Undef);
+        binReasons.push(lit_Undef);
         assign.push(wUnknown);
+        litValues.push(wUnknown);
+        litValues.push(wUnknown);
         wbool curPhase = wFalse;
 #ifdef SATURNIN_PARALLEL
         if(threadId != 0 && (rand.getNext()+threadId)%2 == 0){
@@ -614,77 +1909,49 @@ void Solver::ensureCapacity(Var v, unsigned int nbInitialized) {
         }
 #endif /* SATURNIN_PARALLEL */
         phase.push(curPhase);
+        targetPhase.push(curPhase);
+        bestPhase.push(curPhase);
         presumption.push(wUnknown);
         previousPhase.push(wFalse);
         varActivityValue.push(0.0);
         varActivity.add(nbInitialized + i);
-        varLevel.push(0);
+        vmtfLinks.push();
+        vmtfAppend(nbInitialized + i);
+        LrbData lrb;
+        lrb.assigned = conflicts;
+        lrb.unassigned = conflicts;
+        lrb.participated = 0;
+        lrb.reasoned = 0;
+        lrbData.push(lrb);
+        VarData data;
+        data.reason = CRef_Undef;
+        data.level = 0;
+        data.seen = false;
+        varData.push(data);
         levelLBDChecked.push(0);
-        binWatched.push();
-        watchedClauses.push();
-        monowatch.push();
-        reasons.push((Lit*) nullptr);
-        seen.push(false);
+        watches.push();
         lastReduceSeen.push((unsigned int) - 1);
         pureLitSearch.push(0);
     }
     for (unsigned int i = 0; i < nbVarsToAdd; i++) {
-        binWatched.push();
-        watchedClauses.push();
-        monowatch.push();
+        watches.push();
         pureLitSearch.push(0);
     }
-    nbVar = assign.getSize();
-}
-
-Lit* Solver::binaryPropagate(const Lit l) {
-    SATURNIN_BEGIN_PROFILE;
-    Lit* conflict = nullptr;
-    for (unsigned int i = 0; i < binWatched[l].getSize(); i++) {
-        Lit other = binWatched[l][i];
-        Var vother = VariablesManager::getVar(other);
-        if (assign[vother] != wUnknown) {
-            if (assign[vother] == (VariablesManager::getLitSign(other) ? wTrue : wFalse)) {
-                continue;
-            } else {
-                //conflict found, we have to return the clause other \/ l
-                //however, there is already a clause for vother
-                //therefore, we need an extra space
-                binConflict[0] = other;
-                binConflict[1] = l;
-                binConflict[2] = lit_Undef;
-                conflict = binConflict;
-                i = binWatched[l].getSize();
-            }
-        } else {
-            binReasons[3 * vother] = other;
-            binReasons[3 * vother + 1] = l;
-            ASSERT_EQUAL(lit_Undef, binReasons[3 * vother + 2]);
-            enqueue(other, ((Lit*) binReasons) + 3 * vother);
-        }
+    for (unsigned int i = 0; i < LiteralSearch::padding; i++) {
+        litValues.push(wUnknown);
     }
-    SATURNIN_END_PROFILE(__profile_propagateBin);
-    return conflict;
+    nbVar = assign.getSize();
 }
 
 Lit* Solver::propagate() {
     Lit* conflict = nullptr;
-    while (propagationQueue.getSize() > 0 && conflict == nullptr) {
+    while (propagationHead < stack.getSize() && conflict == nullptr) {
         nbPropag++;
-        const Lit l = propagationQueue.getFirst();
-        propagationQueue.pop();
-
-        //first, let's propagate binary clauses
-        conflict = binaryPropagate(l);
-
-        if (conflict == nullptr) {
-            conflict = propagateWatchedBy(l);
-        }
-
-        if (conflict == nullptr) {
-            conflict = propagateMonoWatched(l);
-        }
+        //the watchers of a literal are visited once it becomes false
+        const Lit l = VariablesManager::oppositeLit(stack[propagationHead]);
+        propagationHead++;
 
+        conflict = propagateWatchedBy(l);
     }
 
 #ifdef DEBUG
@@ -702,111 +1969,144 @@ Lit* Solver::propagate() {
 #endif /* DEBUG */
 
     if (conflict != nullptr) {
-        //TODO: change this with an make empty procedure
-        while (propagationQueue.getSize() > 0) {
-            propagationQueue.pop();
-        }
+        //the remaining literals will be removed by the backtrack
+        propagationHead = stack.getSize();
     }
 
     return conflict;
 }
 
-Lit* Solver::propagateMonoWatched(const Lit l) {
+Lit* Solver::propagateWatchedBy(const Lit l) {
     SATURNIN_BEGIN_PROFILE;
     Lit* conflict = nullptr;
-    while (conflict == nullptr && monowatch[l].getSize() > 0) {
+    //A frozen clause leading to a conflict is watched again by two literals,
+    //one of them being l. It can only be done once we are done with the
+    //watch list of l
+    CRef toAttach = CRef_Undef;
+    watcher_t* currentWatch = (watcher_t*) watches[l];
+    watcher_t* end = currentWatch + watches[l].getSize();
+    watcher_t* destCopy = currentWatch;
 
-        watcher_t nextMonoClause = monowatch[l].getLast();
-        monowatch[l].pop();
-        ASSERT(nextMonoClause.watched->contains(l));
-        ASSERT(nextMonoClause.watched->contains(nextMonoClause.block));
+    while (currentWatch != end && conflict == nullptr) {
+
+        //check if the other literal hasn't been proven true at this
+        //level. For binary clauses, the blocking literal is the other literal
+        //of the clause
+        Lit block = currentWatch->block;
+        wbool blockValue = litValues[block];
+#ifdef PROFILE
+        __profile_visits[currentWatch->getKind()]++;
+#endif /* PROFILE */
 
-        Var vblock = VariablesManager::getVar(nextMonoClause.block);
-        if (assign[vblock] == wUnknown || assign[vblock] == (VariablesManager::getLitSign(nextMonoClause.block) ? wTrue : wFalse)) {
-            monowatch[nextMonoClause.block].push(watcher_t(nextMonoClause.watched, l));
+        if (currentWatch->isBinary()) {
+            *destCopy = *currentWatch;
+            currentWatch++;
+            destCopy++;
+            if (blockValue == wUnknown) {
+                Var vBlock = VariablesManager::getVar(block);
+                binReasons[4 * vBlock] = block;
+                binReasons[4 * vBlock + 1] = l;
+                binReasons[4 * vBlock + 2] = lit_Undef;
+                ASSERT_EQUAL(lit_Undef, binReasons[4 * vBlock + 3]);
+                enqueue(block, binaryReason);
+            } else if (blockValue == wFalse) {
+                //conflict found, we have to return the clause block \/ l
+                //however, there is already a clause for vBlock
+                //therefore, we need an extra space
+                binConflict[0] = block;
+                binConflict[1] = l;
+                binConflict[2] = lit_Undef;
+                conflict = binConflict;
+            }
             continue;
         }
 
-        Clause* cur = nextMonoClause.watched;
-        ASSERT(!cur->isAttached())
-        //look for a new watch
-        Lit* candidate = cur->lits();
-        Var v = VariablesManager::getVar(*candidate);
-
-
-        //p is the position of l
-        unsigned int p = std::numeric_limits<unsigned int>::max();
-        bool found = false;
-        while (!found && *candidate != lit_Undef) {
-            if (*candidate == l) {
-                p = static_cast<unsigned int>(candidate - cur->lits());
+        if (currentWatch->isTernary()) {
+            //both other literals are inline, the clause is never looked at
+            Lit other = currentWatch->getOther();
+            wbool otherValue = litValues[other];
+            *destCopy = *currentWatch;
+            currentWatch++;
+            destCopy++;
+            if (blockValue == wTrue || otherValue == wTrue) {
+                continue;
             }
-            found = assign[v] == wUnknown || assign[v] == (VariablesManager::getLitSign(*candidate) ? wTrue : wFalse);
-            if (!found) {
-                candidate++;
-                v = VariablesManager::getVar(*candidate);
+            if (blockValue == wFalse && otherValue == wFalse) {
+                binConflict[0] = block;
+                binConflict[1] = l;
+                binConflict[2] = other;
+                binConflict[3] = lit_Undef;
+                conflict = binConflict;
+            } else if (otherValue == wFalse) {
+                Var vBlock = VariablesManager::getVar(block);
+                binReasons[4 * vBlock] = block;
+                binReasons[4 * vBlock + 1] = l;
+                binReasons[4 * vBlock + 2] = other;
+                ASSERT_EQUAL(lit_Undef, binReasons[4 * vBlock + 3]);
+                enqueue(block, binaryReason);
+            } else if (blockValue == wFalse) {
+                Var vOther = VariablesManager::getVar(other);
+                binReasons[4 * vOther] = other;
+                binReasons[4 * vOther + 1] = l;
+                binReasons[4 * vOther + 2] = block;
+                ASSERT_EQUAL(lit_Undef, binReasons[4 * vOther + 3]);
+                enqueue(other, binaryReason);
             }
+            continue;
         }
-        if (!found) {
-            //no new watch has been found. Therefore, a conflict appear
-            conflict = cur->lits();
 
-            ASSERT(*candidate == lit_Undef);
-            ASSERT(p < std::numeric_limits<unsigned int>::max());
-            ASSERT_EQUAL(l, cur->getLit(p));
-
-            //remove the clause from the monowatch and put it back to the
-            //'normal' data-structures
-            cur->swapLiterals(p, 1);
-            cur->setAttached(true);
-            addWatchedClause(cur);
-
-#ifdef DEBUG
-            for (unsigned int k = 0; k < monowatch[l].getSize(); k++) {
-                ASSERT(!monowatch[l][k].watched->isAttached());
+        if (currentWatch->isFrozen()) {
+            CRef ref = currentWatch->getRef();
+            Clause* cur = &arena[ref];
+            ASSERT(!cur->isAttached());
+            ASSERT(cur->contains(l));
+            ASSERT(cur->contains(block));
+            if (blockValue != wFalse) {
+                watches[block].push(watcher_t(ref, l, watcher_t::wkFrozen));
+                currentWatch++;
+                continue;
             }
-#endif /* DEBUG */
-
-        } else {
-            ASSERT_EQUAL(VariablesManager::getVar(*candidate), v);
-            ASSERT(cur->contains(*candidate));
-            //we have found another watch
-            //change the watching literal by the one set to true
-            ASSERT(*candidate != l);
-            monowatch[*candidate].push(watcher_t(cur, l));
-        }
-    }
-    if (conflict == nullptr) {
-        monowatch[l].pop(monowatch[l].getSize());
-    } else {
-        ASSERT_EQUAL(l, *(conflict + 1));
-    }
-    SATURNIN_END_PROFILE(__profile_propagateMono);
-    return conflict;
-}
 
-Lit* Solver::propagateWatchedBy(const Lit l) {
-    SATURNIN_BEGIN_PROFILE;
-    Lit* conflict = nullptr;
-    //The pointer to the previous clause
-    watcher_t* currentWatch = (watcher_t*) watchedClauses[l];
-    watcher_t* end = currentWatch + watchedClauses[l].getSize();
-    watcher_t* destCopy = currentWatch;
+            //look for a new watch
+            Lit* candidate = cur->lits();
 
-    long int nbskip = 0;
-    while (currentWatch != end && conflict == nullptr) {
-        bool foundNewWatch = false;
+            //p is the position of l
+            unsigned int p = std::numeric_limits<unsigned int>::max();
+            bool found = false;
+            while (!found && *candidate != lit_Undef) {
+                if (*candidate == l) {
+                    p = static_cast<unsigned int>(candidate - cur->lits());
+                }
+                found = litValues[*candidate] != wFalse;
+                if (!found) {
+                    candidate++;
+                }
+            }
+            currentWatch++;
+            if (!found) {
+                //no new watch has been found. Therefore, a conflict appear
+                conflict = cur->lits();
 
-        ASSERT(currentWatch->watched->getLit(0) == l || currentWatch->watched->getLit(1) == l);
+                ASSERT(*candidate == lit_Undef);
+                ASSERT(p < std::numeric_limits<unsigned int>::max());
+                ASSERT_EQUAL(l, cur->getLit(p));
 
-        //check if the other literal hasn't been proven true at this
-        //level
-        Lit block = currentWatch->block;
-        Var vBlock = VariablesManager::getVar(block);
+                //remove the clause from the frozen ones and put it back to the
+                //'normal' data-structures
+                cur->swapLiterals(p, 1);
+                cur->setAttached(true);
+                toAttach = ref;
+            } else {
+                ASSERT(cur->contains(*candidate));
+                //we have found another watch
+                //change the watching literal by the one set to true
+                ASSERT(*candidate != l);
+                watches[*candidate].push(watcher_t(ref, l, watcher_t::wkFrozen));
+            }
+            continue;
+        }
 
-        if (assign[vBlock] != wUnknown &&
-                assign[vBlock] == (VariablesManager::getLitSign(block) ? wTrue : wFalse)) {
-            //ASSERT(varLevel[vBlock] <= assignLevel);
+        if (blockValue == wTrue) {
             //go to next clause
             *destCopy = *currentWatch;
             currentWatch++;
@@ -814,7 +2114,14 @@ Lit* Solver::propagateWatchedBy(const Lit l) {
             continue;
         }
 
-        Clause* cur = currentWatch->watched;
+        CRef ref = currentWatch->getRef();
+        Clause* cur = &arena[ref];
+
+        //a clause strengthened during the analysis no longer watches l
+        if (cur->getLit(0) != l && cur->getLit(1) != l) {
+            currentWatch++;
+            continue;
+        }
 
         //make sure that l is at position 1
         //That way, if the other watched literal is set to true, we have
@@ -828,69 +2135,51 @@ Lit* Solver::propagateWatchedBy(const Lit l) {
         //update the blocker
         currentWatch->block = cur->getLit(0);
 
-#ifdef DEBUG
-        Clause* next = currentWatch + 1 == end ? nullptr : (currentWatch + 1)->watched;
-        ASSERT(next == nullptr || (next->getLit(0) == l || next->getLit(1) == l));
-#endif /* DEBUG */
-
         Lit first = cur->getLit(0);
-        Var vFirst = VariablesManager::getVar(first);
-        if (assign[vFirst] != wUnknown &&
-                assign[vFirst] == (VariablesManager::getLitSign(first) ? wTrue : wFalse)) {
+        if (litValues[first] == wTrue) {
             *destCopy = *currentWatch;
             currentWatch++;
             destCopy++;
             continue;
         }
 
-        //look for a new watch
-        unsigned int pos = 2;
-        for (; !foundNewWatch && pos < cur->getSize(); pos++) {
-            Lit currentLit = cur->getLit(pos);
-            Var currentVar = VariablesManager::getVar(currentLit);
-            //currentLit is our next watch if the literal is true or
-            //if no value has yet been assigned to currentVar
-            foundNewWatch = assign[currentVar] == wUnknown ||
-                    (//assignLevel >= varLevel[currentVar] &&  <= not needed as otherwise it would be assign[currentVar] == wUnknown
-                    assign[currentVar] == (VariablesManager::getLitSign(currentLit) ? wTrue : wFalse));
-        }
+        //look for a new watch: a literal that is true or whose variable
+        //hasn't been assigned yet
+        unsigned int pos = LiteralSearch::findNonFalse(cur->lits(), 2, cur->getSize(), litValues);
+        bool foundNewWatch = pos < cur->getSize();
 
         if (foundNewWatch) {
             //We found a new watcher
 
-            Lit lTmp = cur->getLit(pos - 1);
-            ASSERT(assign[VariablesManager::getVar(lTmp)] == wUnknown ||
-                    assign[VariablesManager::getVar(lTmp)] == (VariablesManager::getLitSign(lTmp) ? wTrue : wFalse));
-            cur->swapLiterals(1, pos - 1);
+            Lit lTmp = cur->getLit(pos);
+            ASSERT(litValues[lTmp] != wFalse);
+            cur->swapLiterals(1, pos);
 
             //Remove the current clause from the list of l
             currentWatch++;
-            nbskip++;
 
             //Add the clause to the watched list of the literal of lTmp
             ASSERT(cur->getLit(1) == lTmp);
             ASSERT(lTmp != l);
-            watchedClauses[lTmp].push(watcher_t(cur, cur->getLit(0)));
+            watches[lTmp].push(watcher_t(ref, cur->getLit(0)));
         } else {
             //We didn't found any other watch, we must enqueue another
             //or we may have found a conflict
             Lit secondLit = cur->getLit(0);
-            Var secondVar = VariablesManager::getVar(secondLit);
-            if (assign[secondVar] != wUnknown &&
-                    assign[secondVar] != (VariablesManager::getLitSign(secondLit) ? wTrue : wFalse)) {
-                ASSERT(varLevel[secondVar] <= assignLevel);
+            *destCopy = *currentWatch;
+            destCopy++;
+            currentWatch++;
+            if (litValues[secondLit] == wFalse) {
+                ASSERT(varData[VariablesManager::getVar(secondLit)].level <= assignLevel);
                 //we found a conflict!
                 conflict = cur->lits();
-
-                //copy the remaining watches
-                memmove(destCopy, currentWatch, (end - currentWatch) * sizeof (watcher_t));
-
             } else{ 
-                ASSERT(assign[secondVar] == wUnknown);
-                enqueue(secondLit, cur->lits());
+                ASSERT(litValues[secondLit] == wUnknown);
+                enqueue(secondLit, ref);
 
-                //we may re-compute the lbd value of the clause
-                if (cur->getLBD() > 3) {
+                //we may re-compute the lbd value of the clause, unless it
+                //was removed and only waits for its watchers to be dropped
+                if (cur->getLBD() > 3 && !cur->isToRemove()) {
                     unsigned int lbd = computeLBD(cur);
                     ASSERT(lbd < cur->getSize());
                     if (lbd < cur->getLBD()) {
@@ -904,17 +2193,22 @@ Lit* Solver::propagateWatchedBy(const Lit l) {
                         lbdValues[lbd]++;
                     }
                 }
-
-                *destCopy = *currentWatch;
-                destCopy++;
-                currentWatch++;
             }
         }
     }
-    ASSERT(nbskip == end - destCopy || conflict != nullptr);
 
-    watchedClauses[l].pop(nbskip);
-    SATURNIN_END_PROFILE(__profile_propagateWatched);
+    //copy the remaining watches
+    if (currentWatch != end) {
+        ASSERT(conflict != nullptr);
+        memmove(destCopy, currentWatch, (end - currentWatch) * sizeof (watcher_t));
+        destCopy += end - currentWatch;
+    }
+    watches[l].pop(static_cast<unsigned int>(end - destCopy));
+
+    if (toAttach != CRef_Undef) {
+        addWatchedClause(toAttach);
+    }
+    SATURNIN_END_PROFILE(__profile_propagate);
     return conflict;
 }
 
@@ -926,8 +2220,8 @@ bool Solver::litRedundant(Lit p, unsigned int abstract_levels, Array<Lit>& analy
     analyze_stack.push(p);
     int top = analyze_toclear.getSize();
     while (analyze_stack.getSize() > 0) {
-        ASSERT(reasons[VariablesManager::getVar(analyze_stack.get(analyze_stack.getSize() - 1))] != nullptr);
-        Lit* c = reasons.get(VariablesManager::getVar(analyze_stack.get(analyze_stack.getSize() - 1)));
+        ASSERT(varData[VariablesManager::getVar(analyze_stack.get(analyze_stack.getSize() - 1))].reason != CRef_Undef);
+        Lit* c = getReason(VariablesManager::getVar(analyze_stack.get(analyze_stack.getSize() - 1)));
         analyze_stack.pop();
 #ifdef SATURNIN_DB
         resolvedClauses.push(c);
@@ -935,15 +2229,15 @@ bool Solver::litRedundant(Lit p, unsigned int abstract_levels, Array<Lit>& analy
         for (unsigned int i = 1; c[i] != lit_Undef; i++) {
             Lit l = c[i];
             Var v = VariablesManager::getVar(l);
-            if (!seen[v] && varLevel.get(v) > 0) {
-                if (reasons[v] != nullptr &&
+            if (!varData[v].seen && varData.get(v).level > 0) {
+                if (varData[v].reason != CRef_Undef &&
                         (abstractLevel(v) & abstract_levels) != 0) {
-                    seen[v] = 1;
+                    varData[v].seen = 1;
                     analyze_stack.push(l);
                     analyze_toclear.push(l);
                 } else {
                     for (unsigned int j = top; j < analyze_toclear.getSize(); j++) {
-                        seen[VariablesManager::getVar(analyze_toclear[j])] = 0;
+                        varData[VariablesManager::getVar(analyze_toclear[j])].seen = 0;
                     }
                     analyze_toclear.pop(analyze_toclear.getSize() - top);
                     return false;
@@ -966,7 +2260,7 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
     for(unsigned int i = 0; conflictingClause[i]!=lit_Undef; i++){
         ASSERT(assign[VariablesManager::getVar(conflictingClause[i])] != wUnknown);
         ASSERT(getLitValue(conflictingClause[i]) == wFalse);
-        if(varLevel[VariablesManager::getVar(conflictingClause[i])] == assignLevel){
+        if(varData[VariablesManager::getVar(conflictingClause[i])].level == assignLevel){
             nbVarThisLvl++;
         }
     }
@@ -981,9 +2275,9 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
     unsigned int index = stack.getSize() - 1;
 
 #ifdef DEBUG
-    ASSERT_EQUAL(nbVar, seen.getSize());
+    ASSERT_EQUAL(nbVar, varData.getSize());
     for (unsigned int i = 0; i < nbVar; i++) {
-        ASSERT_EQUAL(false, seen[i])
+        ASSERT(!varData[i].seen)
     }
 #endif
 
@@ -991,9 +2285,15 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
     unsigned int abstract_level = 0;
     Array<Lit> toclear;
 
+    otfsReasons.pop(otfsReasons.getSize());
+    otfsPivots.pop(otfsPivots.getSize());
+    otfsAsserting = CRef_Undef;
+    //the reference of c when it is a reason stored in the arena
+    CRef cRef = CRef_Undef;
 
     Lit* c = conflictingClause;
     do {
+        unsigned int nbProven = 0;
 
         ASSERT(c != nullptr);
         ASSERT(c == conflictingClause || p == c[0]);
@@ -1015,11 +2315,14 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
             //As the clause c was used as a reason, every var used in the clause
             //should have been assigned
             ASSERT(assign[v] != wUnknown);
+            if (varData[v].level == 0) {
+                nbProven++;
+            }
 
-            if (!seen[v] && varLevel[v] > 0) {
-                updateVSIDS(v);
-                seen[v] = true;
-                if (varLevel[v] >= assignLevel) {
+            if (!varData[v].seen && varData[v].level > 0) {
+                bumpVariable(v);
+                varData[v].seen = true;
+                if (varData[v].level >= assignLevel) {
                     nbElementToCheck++;
                 } else {
                     learnt.push(l);
@@ -1033,7 +2336,7 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
                 }
             }
 #ifdef SATURNIN_DB
-            else if(varLevel[v] == 0){
+            else if(varData[v].level == 0){
                 //the variable has been proved
                 Lit unary[] = {l, lit_Undef};
                 db.addResolution(unary, db.nbClausesAdded());
@@ -1041,13 +2344,31 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
 #endif /* SATURNIN_DB*/
         }
 
+#ifndef SATURNIN_DB
+        //the resolvent is made of the literals of the lower levels and the
+        //ones of this level still to resolve. It contains every literal of c
+        //but p and the proven ones, if it has no other literal it subsumes c
+        if (onTheFlySubsumption && cRef != CRef_Undef && arena[cRef].getSize() > 3 &&
+                learnt.getSize() + nbElementToCheck + nbProven == arena[cRef].getSize()) {
+            otfsReasons.push(cRef);
+            otfsPivots.push(p);
+            if (nbElementToCheck == 1) {
+                //the resolvent is the asserting clause
+                otfsAsserting = cRef;
+                otfsAssertingSize = learnt.getSize();
+            }
+        }
+#endif /* SATURNIN_DB */
 
         // Select next clause to look at
         while (
 #ifdef SATURNIN_DB
                 index < stack.getSize() &&
 #endif /* SATURNIN_DB */
-                !seen[VariablesManager::getVar(stack[index])]) {
+                (!varData[VariablesManager::getVar(stack[index])].seen ||
+                varData[VariablesManager::getVar(stack[index])].level < assignLevel)) {
+            //with the chronological backtracking, the literals of the lower
+            //levels may be above the ones of the current level
             index--;
         }
 #ifdef SATURNIN_DB
@@ -1056,7 +2377,11 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
             p = stack[index];
             index--;
 
-            c = reasons[VariablesManager::getVar(p)];
+            c = getReason(VariablesManager::getVar(p));
+            cRef = varData[VariablesManager::getVar(p)].reason;
+            if (cRef == binaryReason) {
+                cRef = CRef_Undef;
+            }
 
             //make sure that the literal that we will use to analyze the next
             //clause is at position 0 in that new clause
@@ -1078,8 +2403,8 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
     //Check that the first literal is from the highest level, and is the only
     //one from that level
     for (unsigned int i = 1; i < learnt.getSize(); i++) {
-        ASSERT(varLevel[VariablesManager::getVar(learnt.get(i))] <
-                varLevel[VariablesManager::getVar(learnt.get(0))]);
+        ASSERT(varData[VariablesManager::getVar(learnt.get(i))].level <
+                varData[VariablesManager::getVar(learnt.get(0))].level);
     }
 
 #endif /* DEBUG */
@@ -1089,7 +2414,7 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
     unsigned int i = 1;
     unsigned int j = 1;
     for (; i < learnt.getSize(); i++) {
-        if (reasons[VariablesManager::getVar(learnt[i])] == nullptr ||
+        if (varData[VariablesManager::getVar(learnt[i])].reason == CRef_Undef ||
                 !litRedundant(learnt[i], abstract_level, toclear)) {
             learnt[j] = learnt[i];
             j++;
@@ -1098,17 +2423,163 @@ void Solver::computeLearntClause(Lit* conflictingClause, Array<Lit>& learnt){
     ASSERT(j <= i);
     //remove the useless literals
     learnt.pop(i - j);
+    nbMinimizedLits += i - j;
+
+    if (branching == BranchingHeuristic::LRB) {
+        //the reason side rate: the variables that implied the literals of
+        //the learnt clause without being part of the analysis
+        for (unsigned int k = 0; k < learnt.getSize(); k++) {
+            Lit* r = getReason(VariablesManager::getVar(learnt[k]));
+            for (unsigned int l = 1; r != nullptr && r[l] != lit_Undef; l++) {
+                Var v = VariablesManager::getVar(r[l]);
+                if (!varData[v].seen && varData[v].level > 0) {
+                    varData[v].seen = true;
+                    lrbData[v].reasoned++;
+                    toclear.push(r[l]);
+                }
+            }
+        }
+    }
 
 
     //clear the seen array
     for (unsigned int k = 0; k < toclear.getSize(); k++) {
-        seen[VariablesManager::getVar(toclear.get(k))] = false;
+        varData[VariablesManager::getVar(toclear.get(k))].seen = false;
+    }
+
+    if (binaryMinimization) {
+        minimizeWithBinaries(learnt);
+    }
+}
+
+void Solver::minimizeWithBinaries(Array<Lit>& learnt) {
+    if (learnt.getSize() <= 2 || learnt.getSize() > binaryMinimizationSize) {
+        return;
+    }
+    lbdTimeStamp++;
+    unsigned int lbd = 0;
+    for (unsigned int k = 0; k < learnt.getSize(); k++) {
+        unsigned int varLvl = varData[VariablesManager::getVar(learnt[k])].level;
+        if (levelLBDChecked[varLvl] != lbdTimeStamp) {
+            levelLBDChecked[varLvl] = lbdTimeStamp;
+            lbd++;
+            if (lbd > binaryMinimizationLBD) {
+                return;
+            }
+        }
+    }
+    for (unsigned int k = 1; k < learnt.getSize(); k++) {
+        varData[VariablesManager::getVar(learnt[k])].seen = true;
+    }
+    //a binary clause (learnt[0], ¬l) with l in the learnt clause removes l.
+    //The literals of the learnt clause are false, therefore ¬l is true
+    unsigned int nbRemoved = 0;
+    const Array<watcher_t>& ws = watches[learnt[0U]];
+    for (unsigned int k = 0; k < ws.getSize() && ws[k].isBinary(); k++) {
+        Lit imp = ws[k].block;
+        Var v = VariablesManager::getVar(imp);
+        if (varData[v].seen && litValues[imp] == wTrue) {
+            varData[v].seen = false;
+            nbRemoved++;
+#ifdef SATURNIN_DB
+            Lit bin[] = {learnt[0U], imp, lit_Undef};
+            db.addResolution(bin, db.nbClausesAdded());
+#endif /* SATURNIN_DB */
+        }
+    }
+    unsigned int j = 1;
+    for (unsigned int k = 1; k < learnt.getSize(); k++) {
+        Var v = VariablesManager::getVar(learnt[k]);
+        if (varData[v].seen) {
+            varData[v].seen = false;
+            learnt[j++] = learnt[k];
+        }
+    }
+    ASSERT_EQUAL(learnt.getSize() - nbRemoved, j);
+    learnt.pop(nbRemoved);
+    nbBinaryMinimizedLits += nbRemoved;
+}
+
+CRef Solver::strengthenReasons(const Array<Lit>& learnt) {
+    CRef replacing = CRef_Undef;
+    for (unsigned int k = 0; k < otfsReasons.getSize(); k++) {
+        CRef ref = otfsReasons[k];
+        Clause& c = arena[ref];
+        //an initial clause of size 4 would become ternary-watched, while its
+        //former watchers still refer to it
+        if (!c.isAttached() || c.isToRemove() || (!c.isLearnt() && c.getSize() == 4)) {
+            continue;
+        }
+        //the reason may only become the learnt clause if it is still a
+        //reason once strengthened
+        bool replaces = ref == otfsAsserting && learnt.getSize() == otfsAssertingSize &&
+                learnt.getSize() > 2 && (c.isLearnt() || c.getSize() > 4);
+        unsigned int sz = c.getSize();
+        unsigned int pivot = sz;
+        unsigned int first = sz;
+        unsigned int second = sz;
+        for (unsigned int i = 0; i < sz; i++) {
+            Lit l = c.getLit(i);
+            if (l == otfsPivots[k]) {
+                pivot = i;
+            } else if (replaces) {
+                if (l == learnt[0U]) {
+                    first = i;
+                } else if (l == learnt[1U]) {
+                    second = i;
+                }
+            } else if (litValues[l] != wFalse) {
+                if (first == sz) {
+                    first = i;
+                } else if (second == sz) {
+                    second = i;
+                }
+            }
+        }
+        //without two literals to watch, the clause is kept as it is
+        if (pivot == sz || first == sz || second == sz) {
+            continue;
+        }
+        Lit a = c.getLit(first);
+        Lit b = c.getLit(second);
+        arena.removeLit(ref, pivot);
+        for (unsigned int i = 0; i < c.getSize(); i++) {
+            if (c.getLit(i) == a) {
+                c.swapLiterals(0, i);
+            }
+        }
+        for (unsigned int i = 1; i < c.getSize(); i++) {
+            if (c.getLit(i) == b) {
+                c.swapLiterals(1, i);
+            }
+        }
+        if (c.isLearnt()) {
+            unsigned int lbd = computeLBD(&c);
+            if (lbd < c.getLBD()) {
+                ASSERT(lbdValues[c.getLBD()] > 0);
+                lbdValues[c.getLBD()]--;
+                c.setLBD(lbd);
+                ASSERT(lbd != 0);
+                lbdValues[lbd]++;
+            }
+        }
+        //the former watchers are dropped once their list is walked, as they
+        //no longer find their literal among the two first ones
+        addWatchedClause(ref);
+        nbOnTheFlyStrengthened++;
+        if (replaces) {
+            replacing = ref;
+        }
     }
+    return replacing;
 }
 
 unsigned int Solver::analyze(Lit* conflictingClause, Array<Lit>& learnt) {
     SATURNIN_BEGIN_PROFILE;
     computeLearntClause(conflictingClause, learnt);
+    if (branching == BranchingHeuristic::VMTF) {
+        vmtfFlushBumps();
+    }
 
     //Now, we need to look up for the highest level of the different assignment
     //levels of the literals learnt[1] to learnt[size-1]
@@ -1121,10 +2592,10 @@ unsigned int Solver::analyze(Lit* conflictingClause, Array<Lit>& learnt) {
         destinationLevel = 0;
     } else {
         unsigned int pos = 1;
-        unsigned int maxV = varLevel[VariablesManager::getVar(learnt[pos])];
+        unsigned int maxV = varData[VariablesManager::getVar(learnt[pos])].level;
         for (unsigned int k = 2; k < learnt.getSize(); k++) {
-            if (varLevel[VariablesManager::getVar(learnt[k])] > maxV) {
-                maxV = varLevel[VariablesManager::getVar(learnt[k])];
+            if (varData[VariablesManager::getVar(learnt[k])].level > maxV) {
+                maxV = varData[VariablesManager::getVar(learnt[k])].level;
                 pos = k;
             }
         }
@@ -1146,7 +2617,7 @@ unsigned int Solver::analyze(Lit* conflictingClause, Array<Lit>& learnt) {
     }
 
     for (unsigned int k = 0; k < nbVar; k++) {
-        ASSERT_EQUAL(false, seen[k])
+        ASSERT(!varData[k].seen)
     }
 
 #endif
@@ -1168,38 +2639,36 @@ wbool Solver::simplify() {
         stopSimplification = true;
         unsigned int i = 0;
         while (i < clauses.getSize() && !asyncStop) {
-            Clause* c = clauses[i];
+            CRef ref = clauses[i];
+            Clause* c = &arena[ref];
             bool removed = false;
             unsigned int j = 0;
             bool simpl = false;
             while (!removed && !simpl && j < c->getSize()) {
                 Lit aLit = c->getLit(j);
-                if (assign[VariablesManager::getVar(aLit)] != wUnknown) {
-                    wbool v = getLitValue(aLit);
-                    ASSERT(v != wUnknown);
+                wbool v = litValues[aLit];
+                if (v != wUnknown) {
                     if (v == wTrue) {
                         //The clause contains a literal proven true, we may remove
                         //the clause from our learnt clause database
-                        ASSERT(c == clauses[i]);
+                        ASSERT(ref == clauses[i]);
                         clauses[i] = clauses[clauses.getSize() - 1];
                         clauses.pop();
-                        stopWatchClause(c->getLit(0), c);
-                        stopWatchClause(c->getLit(1), c);
-                        allocator.releaseClause(c);
+                        removeClause(ref);
                         removed = true;
                         nbRemoved++;
                     } else {
                         //The clause contains a literal proven false, we may
                         //simplify the clause
-                        ASSERT(c == clauses[i]);
-                        stopWatchClause(c->getLit(0), c);
-                        stopWatchClause(c->getLit(1), c);
+                        ASSERT(ref == clauses[i]);
+                        //the arena may move while the simplified clause is
+                        //added, therefore c is not valid afterwards
                         if (!addClause(c->lits(), c->getSize(), true)) {
                             state = wFalse;
                         }
                         clauses[i] = clauses[clauses.getSize() - 1];
                         clauses.pop();
-                        allocator.releaseClause(c);
+                        removeClause(ref);
                         simpl = true;
                         nbReduced++;
                         j++;
@@ -1213,6 +2682,7 @@ wbool Solver::simplify() {
             }
         }
     }
+    cleanWatches();
     nbInitialClausesRemoved += nbRemoved;
     nbInitialClausesReduced += nbReduced;
 
@@ -1227,33 +2697,36 @@ wbool Solver::phasedElimination() {
 
     ASSERT_EQUAL(0U, assignLevel);
     ASSERT_EQUAL(2 * nbVar, pureLitSearch.getSize());
-    ASSERT_EQUAL(0U, propagationQueue.getSize());
+    ASSERT_EQUAL(stack.getSize(), propagationHead);
 
     if (state == wUnknown) {
         nbPureLitSearch++;
 
         //check which literals are used by the clauses of the initial problem
         for (unsigned int i = 0; i < clauses.getSize(); i++) {
-            Clause* c = clauses[i];
-            for (unsigned j = 0; j < c->getSize(); j++) {
-                Lit l = c->getLit(j);
+            const Clause& c = arena[clauses[i]];
+            for (unsigned j = 0; j < c.getSize(); j++) {
+                Lit l = c.getLit(j);
                 pureLitSearch[l] = nbPureLitSearch;
             }
         }
         //check which literals are used by binary clauses
-        for (unsigned int i = 0; i < binWatched.getSize(); i++) {
-            //we don't need to go through the elements of binWatched[i] since
-            //for each element x in binWatched[i], binWatched[x] contains
-            //i
-            if (binWatched[i].getSize() != 0) {
-                pureLitSearch[i] = nbPureLitSearch;
+        for (unsigned int i = 0; i < watches.getSize(); i++) {
+            //we don't need to go through the other literal of the binary
+            //watchers in watches[i] since for each binary watcher x in
+            //watches[i], watches[x] contains a binary watcher on i
+            for (unsigned int j = 0; j < watches[i].getSize(); j++) {
+                if (watches[i][j].isBinary()) {
+                    pureLitSearch[i] = nbPureLitSearch;
+                    break;
+                }
             }
         }
         //check which literals are used by the learnt clauses
         for (unsigned int i = 0; i < learntClauses.getSize(); i++) {
-            Clause* c = learntClauses[i];
-            for (unsigned j = 0; j < c->getSize(); j++) {
-                Lit l = c->getLit(j);
+            const Clause& c = arena[learntClauses[i]];
+            for (unsigned j = 0; j < c.getSize(); j++) {
+                Lit l = c.getLit(j);
                 pureLitSearch[l] = nbPureLitSearch;
             }
         }
@@ -1297,9 +2770,19 @@ wbool Solver::phasedElimination() {
 bool Solver::solve(unsigned int maxNbRestarts) {
     state = simplify();
     state = phasedElimination();
+    if (state == wUnknown && subsumption && conflicts >= nextSubsume) {
+        state = subsume();
+        nextSubsume = conflicts + subsumeInterval;
+    }
+    if (state == wUnknown && probing && conflicts >= nextProbe) {
+        state = probe();
+        if (state == wUnknown && transitiveReduction) {
+            state = reduceTransitive();
+        }
+        nextProbe = conflicts + probeInterval;
+    }
     while (state == wUnknown && restarts <= maxNbRestarts && !asyncStop) {
         restarts++;
-        ASSERT_EQUAL((unsigned int) 0, assignLevel);
         state = search(vvalue * factor);
         //compute the next uvalue and vvalue
         if ((uvalue & -uvalue) == vvalue) {
@@ -1309,18 +2792,33 @@ bool Solver::solve(unsigned int maxNbRestarts) {
             vvalue = vvalue * 2;
         }
         if (state == wUnknown && restarts <= maxNbRestarts && assignLevel > 0) {
-            backtrack(assignLevel);
-            ASSERT_EQUAL(0U, assignLevel);
-            if (propagationQueue.getSize() > 0) {
-                propagationQueue.pop();
+            unsigned int reused = getReusableLevels();
+            nbReusedLevels += reused;
+            if (reused < assignLevel) {
+                backtrack(assignLevel - reused);
             }
+            if (assignLevel == 0) {
 #ifdef SATURNIN_PARALLEL
-            //import the clauses from other solvers
-            importClauses();
-            importProvenLiterals();
+                //import the clauses from other solvers
+                importClauses();
+                importProvenLiterals();
 #endif /* SATURNIN_PARALLEL */
-            state = simplify();
-            ASSERT_EQUAL(0U, propagationQueue.getSize());
+                state = simplify();
+                ASSERT_EQUAL(stack.getSize(), propagationHead);
+                if (state == wUnknown && subsumption && conflicts >= nextSubsume) {
+                    state = subsume();
+                    subsumeInterval += subsumeInterval / 2;
+                    nextSubsume = conflicts + subsumeInterval;
+                }
+                if (state == wUnknown && probing && conflicts >= nextProbe) {
+                    state = probe();
+                    if (state == wUnknown && transitiveReduction) {
+                        state = reduceTransitive();
+                    }
+                    probeInterval += probeInterval / 2;
+                    nextProbe = conflicts + probeInterval;
+                }
+            }
         }
     }
 #ifdef SATURNIN_PARALLEL
@@ -1336,10 +2834,55 @@ bool Solver::solve(unsigned int maxNbRestarts) {
         }
     }
 #endif /* SATURNIN_PARALLEL */
+    if (state == wTrue && extensionStack.getSize() > 0) {
+        extendModel();
+    }
 
     return state != wUnknown;
 }
 
+unsigned int Solver::getReusableLevels() {
+#ifdef SATURNIN_PARALLEL
+    //the clauses of the other solvers are imported at level 0
+    return 0;
+#else
+    //the reduce and the simplification are only performed at level 0
+    if (!reuseTrail || nbConfBeforeReduce == 0) {
+        return 0;
+    }
+    if (branching == BranchingHeuristic::VMTF) {
+        //the decisions that are more recent in the queue than the next
+        //decision would be taken again
+        Var next = pickBranchVar();
+        if (next == var_Undef) {
+            return 0;
+        }
+        uint64_t stamp = vmtfLinks[next].stamp;
+        unsigned int lvl = 0;
+        while (lvl < assignLevel &&
+                vmtfLinks[VariablesManager::getVar(stack[stackPointer[lvl + 1]])].stamp > stamp) {
+            lvl++;
+        }
+        return lvl;
+    }
+    //find the variable that would be decided first after the restart
+    while (varActivity.getSize() > 0 &&
+            assign[varActivity.getMin()] != wUnknown) {
+        varActivity.removeMin();
+    }
+    if (varActivity.getSize() == 0) {
+        return 0;
+    }
+    double next = varActivityValue[varActivity.getMin()];
+    unsigned int lvl = 0;
+    while (lvl < assignLevel &&
+            varActivityValue[VariablesManager::getVar(stack[stackPointer[lvl + 1]])] > next) {
+        lvl++;
+    }
+    return lvl;
+#endif /* SATURNIN_PARALLEL */
+}
+
 wbool Solver::search(int) {
     int currentNbConflict = 0;
     bool restart = false;
@@ -1361,28 +2904,22 @@ wbool Solver::search(int) {
             ASSERT_EQUAL(assignLevel + 1, stackPointer.getSize());
 
             //look for next variable
-            if (varActivity.getSize() > 0) {
-                Var v = varActivity.removeMin();
-                while (assign[v] != wUnknown && varActivity.getSize() > 0) {
-                    v = varActivity.removeMin();
-                }
-                if (varActivity.getSize() == 0 && assign[v] != wUnknown) {
-                    //we couldn't find a variable not assigned
-                    //we did it, a solution was found!
-                    answer = wTrue;
-                } else {
-                    Lit l = 0;
-                    if(presumption[v] == wUnknown){
-                        l = VariablesManager::getLit(v, phase[v] == wTrue);
-                    }else{
-                        l = VariablesManager::getLit(v, presumption[v] == wTrue);
-                    }
-
-                    enqueue(l);
-                }
-            } else {
+            SATURNIN_BEGIN_PROFILE;
+            Var v = pickBranchVar();
+            SATURNIN_END_PROFILE(__profile_decide);
+            if (v == var_Undef) {
+                //we couldn't find a variable not assigned
                 //we did it, a solution was found!
                 answer = wTrue;
+            } else {
+                Lit l = 0;
+                if(presumption[v] == wUnknown){
+                    l = VariablesManager::getLit(v, (targetPhases ? targetPhase[v] : phase[v]) == wTrue);
+                }else{
+                    l = VariablesManager::getLit(v, presumption[v] == wTrue);
+                }
+                nbDecisions++;
+                enqueue(l);
             }
         } else {
             currentNbConflict++;
@@ -1397,13 +2934,30 @@ wbool Solver::search(int) {
                 lbdSlide.reset();
             }
 
+            //with the chronological backtracking, the conflict may only
+            //involve literals below the current level. The analysis is done
+            //at the level of the conflict
+            if (chronoThreshold != 0) {
+                unsigned int conflictLevel = getMaxLevel(conflictingClause);
+                if (conflictLevel < assignLevel) {
+                    backtrack(assignLevel - conflictLevel);
+                }
+            }
+
+            if (targetPhases || rephasing) {
+                updateTargetPhase();
+            }
+            if (rephasing && conflicts >= nextRephase) {
+                rephase();
+            }
+
             //if we already are on level 0, it means we have proven UNSAT
             if (assignLevel == 0) {
                 answer = wFalse;
             } else {
-                Clause* learnt = treatConflict(conflictingClause);
+                CRef learnt = treatConflict(conflictingClause);
                 if(state == wFalse) answer = wFalse;
-                lbdSlide.addValue(learnt != nullptr ? learnt->getLBD() : 1);
+                lbdSlide.addValue(learnt != CRef_Undef ? arena[learnt].getLBD() : 1);
             }
             
             //Check if a restart is needed
@@ -1434,18 +2988,34 @@ wbool Solver::search(int) {
     return answer;
 }
 
-void Solver::enqueue(Lit l, Lit* r) {
+void Solver::enqueue(Lit l, CRef r) {
 
     Var v = VariablesManager::getVar(l);
 
     ASSERT(wUnknown == assign[v]);
-    ASSERT(nullptr == reasons[v]);
+    ASSERT(CRef_Undef == varData[v].reason);
     wbool sign = VariablesManager::getLitSign(l) ? wTrue : wFalse;
     assign[v] = sign;
+    litValues[l] = wTrue;
+    litValues[VariablesManager::oppositeLit(l)] = wFalse;
+
+    phase[v] = sign;
+    varData[v].level = assignLevel;
+    varData[v].reason = r;
+    if (chronoThreshold != 0 && r != CRef_Undef) {
+        //the trail isn't sorted by level anymore: the literal belongs to the
+        //highest level of the other literals of its reason
+        varData[v].level = getMaxLevel(getReason(v) + 1);
+    }
+    if (branching == BranchingHeuristic::LRB) {
+        lrbAssign(v);
+    }
 
 #ifdef DEBUG
     //make sure that every literal but the first is assigned to false
-    for (Lit* i = r + 1; r != nullptr && *i != lit_Undef; i++) {
+    Lit* reason = getReason(v);
+    ASSERT(reason == nullptr || reason[0] == l);
+    for (Lit* i = reason + 1; reason != nullptr && *i != lit_Undef; i++) {
         Var vTmp = VariablesManager::getVar(*i);
         ASSERT(assign[vTmp] != wUnknown);
         ASSERT(assign[vTmp] == (VariablesManager::getLitSign(*i) ? wFalse : wTrue));
@@ -1457,11 +3027,6 @@ void Solver::enqueue(Lit l, Lit* r) {
         lastReduceSeen[v] = nbReducePerformed;
     }
 
-    phase[v] = sign;
-    varLevel[v] = assignLevel;
-    reasons[v] = r;
-
-    propagationQueue.push(VariablesManager::oppositeLit(l));
     stack.push(l);
 
 }
@@ -1478,18 +3043,46 @@ bool Solver::backtrack(unsigned int nbLvl) {
     ASSERT(stackPointer.getSize() > 0);
     unsigned int goal = stackPointer.getLast();
     ASSERT(stack.getSize() > goal);
+    unsigned int newLevel = assignLevel - nbLvl - 1;
     //revert the decisions/propagations that were made
     while (stack.getSize() != goal) {
         Lit l = stack.getLast();
         Var v = VariablesManager::getVar(l);
         stack.pop();
+        if (varData[v].level <= newLevel) {
+            //only happens with the chronological backtracking
+            keptLiterals.push(l);
+            continue;
+        }
         assign[v] = wUnknown;
-        if (!varActivity.contains(v)) {
-            varActivity.add(v);
+        litValues[l] = wUnknown;
+        litValues[VariablesManager::oppositeLit(l)] = wUnknown;
+        if (branching == BranchingHeuristic::VMTF) {
+            if (vmtfLinks[v].stamp > vmtfLinks[vmtfSearch].stamp) {
+                vmtfSearch = v;
+            }
+        } else {
+            if (branching == BranchingHeuristic::LRB) {
+                lrbUnassign(v);
+            }
+            if (!varActivity.contains(v)) {
+                unassignedVars.push(v);
+            }
         }
-        reasons[v] = nullptr;
+        varData[v].reason = CRef_Undef;
 
     }
+    varActivity.addAll(unassignedVars);
+    unassignedVars.pop(unassignedVars.getSize());
+    //repair the stack with the literals that stay assigned, in their
+    //previous order
+    while (keptLiterals.getSize() > 0) {
+        stack.push(keptLiterals.getLast());
+        keptLiterals.pop();
+    }
+    if (propagationHead > goal) {
+        propagationHead = goal;
+    }
     assignLevel -= nbLvl + 1;
 
     //Now that we have successfully remove every thing we made up to level + 1
@@ -1506,11 +3099,65 @@ bool Solver::backtrack(unsigned int nbLvl) {
     return true;
 }
 
-void Solver::printClause(Clause* c, bool color, FILE * out) const {
-    printClause(c->lits(), color, out);
+void Solver::updateTargetPhase() {
+    //the levels below the conflict level are free of conflict
+    unsigned int consistent = stackPointer[assignLevel];
+    if (consistent <= targetTrailSize) {
+        return;
+    }
+    for (unsigned int i = 0; i < consistent; i++) {
+        Var v = VariablesManager::getVar(stack[i]);
+        targetPhase[v] = assign[v];
+    }
+    targetTrailSize = consistent;
+    if (consistent > bestTrailSize) {
+        std::memcpy((wbool*) bestPhase, (wbool*) targetPhase, bestPhase.getSize() * sizeof (wbool));
+        bestTrailSize = consistent;
+    }
+}
+
+void Solver::rephase() {
+    //xorshift32, RandomGenerator repeats itself every 256 values
+    uint32_t rand = 2463534242U + (uint32_t) nbRephases;
+    switch (nbRephases % 6) {
+        case 0:
+            //original phases
+            for (Var v = 0; v < phase.getSize(); v++) {
+                phase[v] = wFalse;
+            }
+            break;
+        case 2:
+            //inverted phases
+            for (Var v = 0; v < phase.getSize(); v++) {
+                phase[v] = wTrue;
+            }
+            break;
+        case 4:
+            //random phases
+            for (Var v = 0; v < phase.getSize(); v++) {
+                rand ^= rand << 13;
+                rand ^= rand >> 17;
+                rand ^= rand << 5;
+                phase[v] = (rand & 1) != 0 ? wTrue : wFalse;
+            }
+            break;
+        default:
+            //best phases, they are searched again from there
+            std::memcpy((wbool*) phase, (wbool*) bestPhase, phase.getSize() * sizeof (wbool));
+            bestTrailSize = 0;
+            break;
+    }
+    std::memcpy((wbool*) targetPhase, (wbool*) phase, targetPhase.getSize() * sizeof (wbool));
+    targetTrailSize = 0;
+    nbRephases++;
+    nextRephase = conflicts + rephaseInterval * (nbRephases + 1);
+}
+
+void Solver::printClause(CRef c, bool color, FILE * out) const {
+    printClause(arena[c].lits(), color, out);
 }
 
-void Solver::printClause(Lit* c, bool color, FILE* out) const {
+void Solver::printClause(const Lit* c, bool color, FILE* out) const {
     for (unsigned int i = 0; c[i] != lit_Undef; i++) {
         printLit(c[i], color, out);
         if (c[i + 1] != lit_Undef) {
@@ -1540,39 +3187,64 @@ bool Solver::validate() {
     return checkClauseSetSatifiability(clauses, assign);
 }
 
-bool Solver::checkClauseSetSatifiability(const Array<Clause*>& set,
+bool Solver::checkClauseSetSatifiability(const Array<CRef>& set,
         const Array<wbool>& interpretation) const {
     for (unsigned int i = 0; i < set.getSize(); i++) {
-        if (!set.get(i)->isSatisfied(interpretation)) {
+        if (!arena[set.get(i)].isSatisfied(interpretation)) {
             return false;
         }
     }
     return true;
 }
 
-Clause* Solver::treatConflict(Lit* conflictingClause){
+CRef Solver::treatConflict(Lit* conflictingClause){
     Array<Lit> res;
     unsigned int btlevel = analyze(conflictingClause, res);
-    Clause* learnt = nullptr;
+    CRef learnt = CRef_Undef;
+    if (chronoThreshold != 0 && res.getSize() > 1 && btlevel > chronoThreshold) {
+        //the learnt clause will be propagated at the level of its second
+        //literal while keeping the levels in between
+        btlevel = 1;
+        nbChronoBacktrack++;
+    }
     if (!backtrack(btlevel)) {
         //we found a contradiction at level 0, therefore the problem is
         //UNSAT
         state = wFalse;
-        return nullptr;
+        return CRef_Undef;
     } else {
-        //a new clause was learnt
-        learnt = addLearntClause(res);
+        CRef strengthened = CRef_Undef;
+        if (otfsReasons.getSize() > 0) {
+            strengthened = strengthenReasons(res);
+        }
+        if (strengthened != CRef_Undef) {
+            //the strengthened reason is the learnt clause, it propagates the
+            //asserting literal instead of a copy
+            ASSERT_EQUAL(res[0U], arena[strengthened].getLit(0));
+            enqueue(res[0U], strengthened);
+            nbOnTheFlyLearnt++;
+            if (arena[strengthened].isLearnt()) {
+                learnt = strengthened;
+            }
+        } else {
+            //a new clause was learnt
+            learnt = addLearntClause(res);
+        }
 #ifdef SATURNIN_PARALLEL
-        exportClause(res, learnt == nullptr ? 1 : learnt->getLBD());
+        exportClause(res, learnt == CRef_Undef ? 1 : arena[learnt].getLBD());
 #endif /* SATURNIN_PARALLEL */
-        if (learnt != nullptr) {
-            unsigned int lbd = learnt->getLBD();
+        if (learnt != CRef_Undef) {
+            unsigned int lbd = arena[learnt].getLBD();
             lbdMean.addValue(lbd);
         } else if (res.getSize() == 2) {
             lbdMean.addValue(1);
         }
     }
-    vsidsInc *= (1 / vsidsDec);
+    if (branching == BranchingHeuristic::VSIDS) {
+        vsidsInc *= (1 / vsidsDec);
+    } else if (branching == BranchingHeuristic::LRB && lrbStep > lrbMinStep) {
+        lrbStep -= 1e-6;
+    }
     return learnt;
 }
 
@@ -1612,7 +3284,7 @@ bool Solver::importClause(Clause* c){
     //third, we look for the variable with the highest level
     for(unsigned int i = 0, j = 0; i<sz; i++){
         if(assign[VariablesManager::getVar(c->getLit(i))] != wUnknown && 
-                varLevel[VariablesManager::getVar(c->getLit(i))] == 0){
+                varData[VariablesManager::getVar(c->getLit(i))].level == 0){
             if(getLitValue(c->getLit(i)) == wTrue){
                 return true;
             }
@@ -1647,11 +3319,11 @@ bool Solver::importClause(Clause* c){
         if (sz == 2) {
             Lit a = c->getLit(0);
             Lit b = c->getLit(1);
-            binWatched[a].push(b);
-            binWatched[b].push(a);
+            addBinaryWatch(a, b);
             nbBin++;
         } else {
-            Clause* newClause = allocator.createClause(c->lits(), sz);
+            CRef ref = arena.createClause(c->lits(), sz);
+            Clause* newClause = &arena[ref];
             ASSERT(newClause->isAttached());
             unsigned int lbd = computeLBD(newClause);
             ASSERT(lbd != 0);
@@ -1661,8 +3333,8 @@ bool Solver::importClause(Clause* c){
             lbdValues[lbd]++;
             newClause->setLBD(lbd);
             newClause->setIndex(learntClauses.getSize());
-            learntClauses.push(newClause);
-            addWatchedClause(newClause);
+            learntClauses.push(ref);
+            addWatchedClause(ref);
         }
     }
     
@@ -1749,32 +3421,31 @@ bool Solver::importProvenLiterals() {
 #endif /* SATURNIN_PARALLEL */
 
 size_t Solver::getMemoryFootprint() const {
-    size_t mem = varLevel.getMemoryFootprint() + assign.getMemoryFootprint();
+    size_t mem = varData.getMemoryFootprint() + assign.getMemoryFootprint();
+    mem += litValues.getMemoryFootprint();
     mem += phase.getMemoryFootprint() + previousPhase.getMemoryFootprint();
+    mem += targetPhase.getMemoryFootprint() + bestPhase.getMemoryFootprint();
     mem += presumption.getMemoryFootprint();
-    mem += reasons.getMemoryFootprint() + binReasons.getMemoryFootprint();
-    mem += binWatched.getMemoryFootprint();
+    mem += binReasons.getMemoryFootprint();
 #ifdef SATURNIN_DB
     mem += db.getMemoryFootprint();
 #endif /* SATURNIN_DB */
-    for (unsigned int i = 0; i < binWatched.getSize(); i++) {
-        mem += binWatched.get(i).getMemoryFootprint();
-    }
-    for (unsigned int i = 0; i < watchedClauses.getSize(); i++) {
-        mem += watchedClauses.get(i).getMemoryFootprint();
-    }
-    mem += monowatch.getMemoryFootprint();
-    for (unsigned int i = 0; i < watchedClauses.getSize(); i++) {
-        mem += monowatch.get(i).getMemoryFootprint();
+    for (unsigned int i = 0; i < watches.getSize(); i++) {
+        mem += watches.get(i).getMemoryFootprint();
     }
-    mem += watchedClauses.getMemoryFootprint() + varActivityValue.getMemoryFootprint();
+    mem += watches.getMemoryFootprint() + varActivityValue.getMemoryFootprint();
+    mem += vmtfLinks.getMemoryFootprint() + lrbData.getMemoryFootprint();
     mem += clauses.getMemoryFootprint() + learntClauses.getMemoryFootprint();
-    mem += propagationQueue.getMemoryFootprint() + stack.getMemoryFootprint();
+    mem += removedClauses.getMemoryFootprint();
+    mem += removedTernaries.getMemoryFootprint();
+    mem += stack.getMemoryFootprint() + keptLiterals.getMemoryFootprint();
     mem += stackPointer.getMemoryFootprint() + varActivity.getMemoryFootprint();
-    mem += allocator.getMemoryFootprint();
-    mem += levelLBDChecked.getMemoryFootprint() + seen.getMemoryFootprint();
+    mem += unassignedVars.getMemoryFootprint();
+    mem += arena.getMemoryFootprint();
+    mem += levelLBDChecked.getMemoryFootprint();
     mem += pureLitSearch.getMemoryFootprint();
     mem += lbdValues.getMemoryFootprint() + map.getMemoryFootprint() + revertMap.getMemoryFootprint();
+    mem += extensionStack.getMemoryFootprint() + model.getMemoryFootprint();
     return mem;
 }
 
@@ -0,0 +1,111 @@
+#include "ClauseArenaTest.h"
+#include "../../include/saturnin/ClauseArena.h"
+#include "../../include/saturnin/Clause.h"
+#include "../../include/saturnin/VariablesManager.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ClauseArenaTest);
+
+void ClauseArenaTest::testCreation() {
+    saturnin::ClauseArena arena(64);
+    CPPUNIT_ASSERT_EQUAL(64U, arena.getCapacity());
+    CPPUNIT_ASSERT_EQUAL(0U, arena.getSize());
+    CPPUNIT_ASSERT_EQUAL(0U, arena.getWasted());
+    CPPUNIT_ASSERT_EQUAL(0U, arena.getNbClauses());
+}
+
+void ClauseArenaTest::testClauseRetrieval() {
+    saturnin::ClauseArena arena(64);
+    saturnin::Lit a[3] = {(saturnin::Lit)0, (saturnin::Lit)2, (saturnin::Lit)4};
+    saturnin::Lit b[4] = {(saturnin::Lit)1, (saturnin::Lit)3, (saturnin::Lit)5, (saturnin::Lit)7};
+    saturnin::CRef ra = arena.createClause(a, 3);
+    saturnin::CRef rb = arena.createClause(b, 4, 2);
+    CPPUNIT_ASSERT_EQUAL(0U, ra);
+    CPPUNIT_ASSERT_EQUAL(saturnin::ClauseArena::getNbWords(3), rb);
+    CPPUNIT_ASSERT_EQUAL(saturnin::ClauseArena::getNbWords(3) + saturnin::ClauseArena::getNbWords(4), arena.getSize());
+    CPPUNIT_ASSERT_EQUAL(2U, arena.getNbClauses());
+
+    CPPUNIT_ASSERT_EQUAL(3U, arena[ra].getSize());
+    CPPUNIT_ASSERT_EQUAL(0U, arena[ra].getLBD());
+    CPPUNIT_ASSERT_EQUAL(4U, arena[rb].getSize());
+    CPPUNIT_ASSERT_EQUAL(2U, arena[rb].getLBD());
+    for (unsigned int i = 0; i < 3; i++) {
+        CPPUNIT_ASSERT_EQUAL(a[i], arena[ra].getLit(i));
+    }
+    for (unsigned int i = 0; i < 4; i++) {
+        CPPUNIT_ASSERT_EQUAL(b[i], arena[rb].getLit(i));
+    }
+    CPPUNIT_ASSERT_EQUAL(saturnin::lit_Undef, arena[ra].lits()[3]);
+    CPPUNIT_ASSERT_EQUAL(ra, arena.getRef(arena[ra]));
+    CPPUNIT_ASSERT_EQUAL(rb, arena.getRef(arena[rb]));
+}
+
+void ClauseArenaTest::testExtend() {
+    const unsigned int nbClauses = 100;
+    saturnin::ClauseArena arena(8);
+    saturnin::CRef refs[nbClauses];
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        saturnin::Lit lits[3] = {(saturnin::Lit)(2 * i), (saturnin::Lit)(2 * i + 2), (saturnin::Lit)(2 * i + 5)};
+        refs[i] = arena.createClause(lits, 3);
+    }
+    CPPUNIT_ASSERT(arena.getCapacity() >= arena.getSize());
+    CPPUNIT_ASSERT_EQUAL(nbClauses * saturnin::ClauseArena::getNbWords(3), arena.getSize());
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        CPPUNIT_ASSERT_EQUAL(3U, arena[refs[i]].getSize());
+        CPPUNIT_ASSERT_EQUAL((saturnin::Lit)(2 * i), arena[refs[i]].getLit(0));
+        CPPUNIT_ASSERT_EQUAL((saturnin::Lit)(2 * i + 2), arena[refs[i]].getLit(1));
+        CPPUNIT_ASSERT_EQUAL((saturnin::Lit)(2 * i + 5), arena[refs[i]].getLit(2));
+    }
+}
+
+void ClauseArenaTest::testRelease() {
+    saturnin::ClauseArena arena(64);
+    saturnin::Lit a[3] = {(saturnin::Lit)0, (saturnin::Lit)2, (saturnin::Lit)4};
+    saturnin::CRef ra = arena.createClause(a, 3);
+    saturnin::CRef rb = arena.createClause(a, 2);
+    unsigned int sz = arena.getSize();
+    arena.releaseClause(ra);
+    CPPUNIT_ASSERT_EQUAL(saturnin::CRef_Undef, ra);
+    CPPUNIT_ASSERT_EQUAL(saturnin::ClauseArena::getNbWords(3), arena.getWasted());
+    CPPUNIT_ASSERT_EQUAL(sz, arena.getSize());
+    CPPUNIT_ASSERT_EQUAL(1U, arena.getNbClauses());
+    CPPUNIT_ASSERT_EQUAL(2U, arena[rb].getSize());
+    arena.releaseClause(rb);
+    CPPUNIT_ASSERT_EQUAL(0U, arena.getNbClauses());
+}
+
+void ClauseArenaTest::testRelocate() {
+    saturnin::ClauseArena arena(64);
+    saturnin::Lit a[3] = {(saturnin::Lit)0, (saturnin::Lit)2, (saturnin::Lit)4};
+    saturnin::Lit b[4] = {(saturnin::Lit)1, (saturnin::Lit)3, (saturnin::Lit)5, (saturnin::Lit)7};
+    saturnin::CRef ra = arena.createClause(a, 3);
+    saturnin::CRef rb = arena.createClause(b, 4, 3);
+    arena[rb].setIndex(42);
+    arena.releaseClause(ra);
+
+    saturnin::ClauseArena to(arena.getSize() - arena.getWasted());
+    saturnin::CRef first = rb;
+    saturnin::CRef second = rb;
+    arena.relocate(first, to);
+    arena.relocate(second, to);
+    //the second relocation only retrieves the new reference
+    CPPUNIT_ASSERT_EQUAL(0U, first);
+    CPPUNIT_ASSERT_EQUAL(first, second);
+    CPPUNIT_ASSERT_EQUAL(1U, to.getNbClauses());
+    CPPUNIT_ASSERT_EQUAL(saturnin::ClauseArena::getNbWords(4), to.getSize());
+
+    to.moveTo(arena);
+    CPPUNIT_ASSERT_EQUAL(0U, to.getSize());
+    CPPUNIT_ASSERT_EQUAL(0U, arena.getWasted());
+    CPPUNIT_ASSERT_EQUAL(1U, arena.getNbClauses());
+    CPPUNIT_ASSERT_EQUAL(4U, arena[first].getSize());
+    CPPUNIT_ASSERT_EQUAL(3U, arena[first].getLBD());
+    CPPUNIT_ASSERT_EQUAL(42U, arena[first].getIndex());
+    CPPUNIT_ASSERT(!arena[first].isRelocated());
+    for (unsigned int i = 0; i < 4; i++) {
+        CPPUNIT_ASSERT_EQUAL(b[i], arena[first].getLit(i));
+    }
+
+    //the arena may still grow after having been emptied
+    saturnin::CRef rc = to.createClause(a, 3);
+    CPPUNIT_ASSERT_EQUAL(3U, to[rc].getSize());
+}
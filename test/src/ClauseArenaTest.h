@@ -0,0 +1,64 @@
+/*
+Copyright (c) <2012> <B.Hoessen>
+
+This file is part of saturnin.
+
+saturnin is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+saturnin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CLAUSEARENATEST_H
+#define	CLAUSEARENATEST_H
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class ClauseArenaTest : public CppUnit::TestFixture {
+public:
+
+    CPPUNIT_TEST_SUITE(ClauseArenaTest);
+    CPPUNIT_TEST(testCreation);
+    CPPUNIT_TEST(testClauseRetrieval);
+    CPPUNIT_TEST(testExtend);
+    CPPUNIT_TEST(testRelease);
+    CPPUNIT_TEST(testRelocate);
+    CPPUNIT_TEST_SUITE_END();
+
+    /**
+     * Check the creation of a ClauseArena
+     */
+    void testCreation();
+
+    /**
+     * Check that we can create clauses and retrieve them from their reference
+     */
+    void testClauseRetrieval();
+
+    /**
+     * Check that the clauses are still valid after the arena has grown
+     */
+    void testExtend();
+
+    /**
+     * Check that the released clauses are accounted as wasted memory
+     */
+    void testRelease();
+
+    /**
+     * Check that the clauses can be relocated into another arena
+     */
+    void testRelocate();
+
+};
+
+#endif	/* CLAUSEARENATEST_H */
@@ -105,6 +105,15 @@ void ClauseTest::testAttached(){
     CPPUNIT_ASSERT_EQUAL(0U, cl->getFreezeCounter());
     cl->incrementFreezeCounter();
     CPPUNIT_ASSERT_EQUAL(1U, cl->getFreezeCounter());
+    CPPUNIT_ASSERT(!cl->isToRemove());
+    cl->setToRemove(true);
+    CPPUNIT_ASSERT(cl->isToRemove());
+    CPPUNIT_ASSERT(!cl->isVivified());
+    cl->setVivified(true);
+    CPPUNIT_ASSERT(cl->isVivified());
+    CPPUNIT_ASSERT(cl->isToRemove());
+    CPPUNIT_ASSERT_EQUAL(1U, cl->getFreezeCounter());
+    CPPUNIT_ASSERT_EQUAL(4U, cl->getSize());
 
 }
 
@@ -17,6 +17,10 @@ public:
         return values.get(a) - values.get(b);
     }
 
+    inline double compareKeys(double a, double b) const {
+        return a - b;
+    }
+
     /**
      * Retrieve the value associated with a given key
      * @param key the key we want its value
@@ -1295,3 +1299,123 @@ void HeapTest::testContainLong() {
 
     }
 }
+
+/**
+ * Remove every element of a heap and check that they come in increasing order
+ * @param h the heap to empty
+ * @param values the values of the elements
+ */
+template<class H>
+static void checkIncreasingRemoval(H& h, const saturnin::Array<double>& values) {
+    double min = values.get(h.getMin());
+    while (h.getSize() > 0) {
+        saturnin::Var v = h.removeMin();
+        CPPUNIT_ASSERT(min <= values.get(v));
+        min = values.get(v);
+    }
+}
+
+void HeapTest::testArity() {
+    unsigned int heapSize = 100;
+    saturnin::Array<double> values(heapSize);
+    saturnin::Heap<double, HeapTestComp, 4> h(heapSize, HeapTestComp(values));
+    for (unsigned int i = 0; i < heapSize; i++) {
+        values.push(((i * 37) % heapSize) * 1.0);
+        h.add(i);
+        CPPUNIT_ASSERT_EQUAL(i + 1, h.getSize());
+#ifdef DEBUG
+        CPPUNIT_ASSERT(h.check());
+#endif /* DEBUG */
+    }
+    CPPUNIT_ASSERT_EQUAL(0.0, values[h.getMin()]);
+
+    //move the maximum to the top
+    saturnin::Var v = 27;
+    CPPUNIT_ASSERT_EQUAL(99.0, values[v]);
+    values[v] = -1.0;
+    h.updateValue(v);
+    CPPUNIT_ASSERT_EQUAL(v, h.getMin());
+    checkIncreasingRemoval(h, values);
+}
+
+void HeapTest::testInlineKeys() {
+    unsigned int heapSize = 50;
+    saturnin::Array<double> values(heapSize);
+    saturnin::Heap<double, HeapTestComp, 4, true> h(heapSize, HeapTestComp(values));
+    for (unsigned int i = 0; i < heapSize; i++) {
+        values.push((heapSize - i) * 1.0);
+        h.add(i);
+        CPPUNIT_ASSERT_EQUAL(i, h.getMin());
+    }
+
+    //the heap only sees the new value once it is updated
+    values[0U] = -1.0;
+    CPPUNIT_ASSERT_EQUAL(heapSize - 1, h.getMin());
+    h.updateValue(0);
+    CPPUNIT_ASSERT_EQUAL((saturnin::Var) 0, h.getMin());
+#ifdef DEBUG
+    CPPUNIT_ASSERT(h.check());
+#endif /* DEBUG */
+
+    //change every value and rebuild the heap
+    for (unsigned int i = 0; i < heapSize; i++) {
+        values[i] = i * 1.0;
+    }
+    h.rebuild();
+    CPPUNIT_ASSERT_EQUAL((saturnin::Var) 0, h.getMin());
+    CPPUNIT_ASSERT_EQUAL(heapSize, h.getSize());
+#ifdef DEBUG
+    CPPUNIT_ASSERT(h.check());
+#endif /* DEBUG */
+    for (unsigned int i = 0; i < heapSize; i++) {
+        CPPUNIT_ASSERT_EQUAL(i, h.removeMin());
+    }
+}
+
+void HeapTest::testAddAll() {
+    unsigned int heapSize = 200;
+    saturnin::Array<double> values(heapSize);
+    for (unsigned int i = 0; i < heapSize; i++) {
+        values.push(((i * 73) % heapSize) * 1.0);
+    }
+
+    {
+        //every variable at once: the heap is rebuilt
+        saturnin::Heap<double, HeapTestComp> h(heapSize, HeapTestComp(values));
+        saturnin::Array<saturnin::Var> vars(heapSize);
+        for (unsigned int i = 0; i < heapSize; i++) {
+            vars.push(i);
+        }
+        h.addAll(vars);
+        CPPUNIT_ASSERT_EQUAL(heapSize, h.getSize());
+#ifdef DEBUG
+        CPPUNIT_ASSERT(h.check());
+#endif /* DEBUG */
+        checkIncreasingRemoval(h, values);
+    }
+
+    {
+        //a few variables added to a large heap, then many of them
+        saturnin::Heap<double, HeapTestComp, 4, true> h(heapSize, HeapTestComp(values));
+        saturnin::Array<saturnin::Var> vars(heapSize);
+        for (unsigned int i = 0; i < heapSize - 10; i++) {
+            vars.push(i);
+        }
+        h.addAll(vars);
+        CPPUNIT_ASSERT_EQUAL(heapSize - 10, h.getSize());
+        vars.pop(vars.getSize());
+        for (unsigned int i = heapSize - 10; i < heapSize; i++) {
+            vars.push(i);
+        }
+        h.addAll(vars);
+        CPPUNIT_ASSERT_EQUAL(heapSize, h.getSize());
+        for (unsigned int i = 0; i < heapSize; i++) {
+            CPPUNIT_ASSERT(h.contains(i));
+        }
+#ifdef DEBUG
+        CPPUNIT_ASSERT(h.check());
+#endif /* DEBUG */
+        checkIncreasingRemoval(h, values);
+        CPPUNIT_ASSERT(!h.contains(0));
+    }
+}
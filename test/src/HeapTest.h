@@ -33,6 +33,9 @@ public:
     CPPUNIT_TEST(testUpdate);
     CPPUNIT_TEST(testPresent);
     CPPUNIT_TEST(testContainLong);
+    CPPUNIT_TEST(testArity);
+    CPPUNIT_TEST(testInlineKeys);
+    CPPUNIT_TEST(testAddAll);
     CPPUNIT_TEST_SUITE_END();
 
     /**
@@ -70,6 +73,22 @@ public:
      */
     void testContainLong();
 
+    /**
+     * Check the order of removal of a 4-ary heap
+     */
+    void testArity();
+
+    /**
+     * Check a heap keeping a copy of the values, with the update and the
+     * rebuild of the values
+     */
+    void testInlineKeys();
+
+    /**
+     * Check the addition of many variables at once, for both layouts
+     */
+    void testAddAll();
+
 
 };
 
@@ -0,0 +1,70 @@
+#include "LiteralSearchTest.h"
+#include "../../include/saturnin/LiteralSearch.h"
+#include "../../include/saturnin/RandomGenerator.h"
+#include "../../include/saturnin/Array.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LiteralSearchTest);
+
+void LiteralSearchTest::testScalar() {
+    saturnin::Lit lits[] = {0, 2, 4, 7, 9};
+    saturnin::wbool values[10 + saturnin::LiteralSearch::padding];
+    for (unsigned int i = 0; i < 10 + saturnin::LiteralSearch::padding; i++) {
+        values[i] = wUnknown;
+    }
+    //every literal but 9 is false
+    values[0] = wFalse;
+    values[1] = wTrue;
+    values[2] = wFalse;
+    values[3] = wTrue;
+    values[4] = wFalse;
+    values[5] = wTrue;
+    values[6] = wTrue;
+    values[7] = wFalse;
+    CPPUNIT_ASSERT_EQUAL(4U, saturnin::LiteralSearch::findNonFalseScalar(lits, 2, 5, values));
+    CPPUNIT_ASSERT_EQUAL(4U, saturnin::LiteralSearch::findNonFalse(lits, 2, 5, values));
+    values[8] = wFalse;
+    values[9] = wFalse;
+    CPPUNIT_ASSERT_EQUAL(5U, saturnin::LiteralSearch::findNonFalseScalar(lits, 2, 5, values));
+    values[4] = wTrue;
+    CPPUNIT_ASSERT_EQUAL(2U, saturnin::LiteralSearch::findNonFalseScalar(lits, 2, 5, values));
+    CPPUNIT_ASSERT_EQUAL(5U, saturnin::LiteralSearch::findNonFalseScalar(lits, 5, 5, values));
+}
+
+void LiteralSearchTest::testIdentical() {
+    const unsigned int nbLits = 200;
+    saturnin::RandomGenerator rand(42);
+    saturnin::Array<saturnin::wbool> values(nbLits + saturnin::LiteralSearch::padding);
+    saturnin::Array<saturnin::Lit> lits(64);
+    for (unsigned int test = 0; test < 500; test++) {
+        values.pop(values.getSize());
+        lits.pop(lits.getSize());
+        //most of the literals are false so that the search goes far
+        for (unsigned int i = 0; i < nbLits; i += 2) {
+            unsigned char r = rand.getNext();
+            if (r < 200) {
+                values.push(wFalse);
+                values.push(wTrue);
+            } else if (r < 230) {
+                values.push(wTrue);
+                values.push(wFalse);
+            } else {
+                values.push(wUnknown);
+                values.push(wUnknown);
+            }
+        }
+        for (unsigned int i = 0; i < saturnin::LiteralSearch::padding; i++) {
+            values.push(wUnknown);
+        }
+        unsigned int sz = 3 + rand.getNext() % 60;
+        for (unsigned int i = 0; i < sz; i++) {
+            lits.push(rand.getNext() % nbLits);
+        }
+        for (unsigned int from = 0; from < sz; from++) {
+            unsigned int expected = saturnin::LiteralSearch::findNonFalseScalar(lits, from, sz, values);
+            CPPUNIT_ASSERT_EQUAL(expected, saturnin::LiteralSearch::findNonFalse(lits, from, sz, values));
+            if (saturnin::LiteralSearch::isAVX2Supported()) {
+                CPPUNIT_ASSERT_EQUAL(expected, saturnin::LiteralSearch::findNonFalseAVX2(lits, from, sz, values));
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+/*
+Copyright (c) <2012> <B.Hoessen>
+
+This file is part of saturnin.
+
+saturnin is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+saturnin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef LITERALSEARCHTEST_H
+#define	LITERALSEARCHTEST_H
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class LiteralSearchTest : public CppUnit::TestFixture {
+public:
+
+    CPPUNIT_TEST_SUITE(LiteralSearchTest);
+    CPPUNIT_TEST(testScalar);
+    CPPUNIT_TEST(testIdentical);
+    CPPUNIT_TEST_SUITE_END();
+
+    /**
+     * Check the scalar search on a small clause
+     */
+    void testScalar();
+
+    /**
+     * Check that every version of the search gives the same position on
+     * random clauses and assignments
+     */
+    void testIdentical();
+
+};
+
+#endif	/* LITERALSEARCHTEST_H */
@@ -81,7 +81,8 @@ void LocalSearchSolverTest::readInstanceAndFillLSSolver(const char* fileName, sa
         if (s.getVarValue(saturnin::VariablesManager::getVar(l)) != wUnknown) continue;
         ASSERT_EQUAL(wUnknown, ls.getProvenValue(saturnin::VariablesManager::getVar(l)));
         
-        const saturnin::Array<saturnin::Lit>& binClauses = s.getBinaryWith(l);
+        saturnin::Array<saturnin::Lit> binClauses;
+        s.getBinaryWith(l, binClauses);
         for (unsigned int j = 0; j < binClauses.getSize(); j++) {
             saturnin::Lit tmp = binClauses.get(j);
             if (tmp < l && s.getVarValue(saturnin::VariablesManager::getVar(tmp)) == wUnknown) {
@@ -96,9 +97,10 @@ void LocalSearchSolverTest::readInstanceAndFillLSSolver(const char* fileName, sa
     }
 
     //add the rest of the clauses
-    const saturnin::Array<saturnin::Clause*>& clauses = s.getInitialClauses();
+    const saturnin::Array<saturnin::CRef>& clauses = s.getInitialClauses();
     for (unsigned int i = 0; i < clauses.getSize(); i++) {
-        ls.addClause(clauses.get(i)->lits(), clauses.get(i)->getSize());
+        const saturnin::Clause& c = s.getClause(clauses.get(i));
+        ls.addClause(c.lits(), c.getSize());
     }
 }
 
@@ -1,6 +1,8 @@
 #include "SimplifierTest.h"
 #include "../../include/saturnin/CNFReader.h"
 #include "../../include/saturnin/Simplifier.h"
+#include "../../include/saturnin/Solver.h"
+#include "TestClauses.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SimplifierTest);
 
@@ -21,7 +23,168 @@ void SimplifierTest::testRevival() {
         s.addClause(lits, r.getClause(i).getSize());
     }
     s.revival(3);
-    CPPUNIT_ASSERT_EQUAL(62U, s.getNbClausesReduced());
+    CPPUNIT_ASSERT_EQUAL(wUnknown, s.getState());
+    CPPUNIT_ASSERT_EQUAL(117U, s.getNbClausesReduced());
 }
 
+void SimplifierTest::testRevivalProbing() {
+    //x3 and x4 are equivalent and can't be both true, therefore x2 x3 x4 and
+    //-x2 x3 x4 conflict. Those clauses are too short to be revived but must
+    //stay watched for the probing to find it
+    const int clauses[][5] = {
+        {3, 1, 4, -2, -5}, {-2, 3, 4, 0}, {4, 3, 5, 0}, {-2, -4, 0}, {-5, -4, 0},
+        {4, 5, -3, 0}, {-5, 4, 0}, {-4, 5, 0}, {4, -5, 2, 1, -3}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > original = toClauses(clauses);
+    saturnin::Simplifier simp(5, original.getSize());
+    for (unsigned int i = 0; i < original.getSize(); i++) {
+        simp.addClause((const saturnin::Lit*) original[i], original[i].getSize());
+    }
+    simp.revival(4);
+    CPPUNIT_ASSERT_EQUAL(wUnknown, simp.getState());
+    CPPUNIT_ASSERT_EQUAL(wFalse, simp.probe());
+    CPPUNIT_ASSERT_EQUAL(wFalse, simp.getState());
+}
+
+void SimplifierTest::testElimination() {
+    saturnin::CNFReader r("instances/dp10s10.shuffled.cnf");
+    r.read();
+    saturnin::Simplifier simp(r.getNbVar(), r.getNbClauses());
+    for (unsigned int i = 0; i < r.getNbClauses(); i++) {
+        simp.addClause((const saturnin::Lit*) r.getClause(i), r.getClause(i).getSize());
+    }
+    simp.revival(r.getAverageLength() + 1);
+    CPPUNIT_ASSERT(simp.getNbEliminatedVars() == 0);
+    unsigned int nbEliminated = simp.eliminateVariables();
+    CPPUNIT_ASSERT(nbEliminated > 0);
+    CPPUNIT_ASSERT_EQUAL(nbEliminated, simp.getNbEliminatedVars());
+    CPPUNIT_ASSERT(simp.getExtensionStack().getSize() > 0);
+
+    //solve the remaining clauses and extend the model
+    saturnin::Solver s(r.getNbVar(), r.getNbClauses());
+    const saturnin::Array<saturnin::Lit>& provenLits = simp.getProvenLit();
+    for (unsigned int i = 0; i < provenLits.getSize(); i++) {
+        CPPUNIT_ASSERT(s.addClause(&provenLits.get(i), 1));
+    }
+    unsigned int nbClauses = 0;
+    const saturnin::Array<saturnin::Array<saturnin::Lit> >& clauses = simp.getClauses();
+    for (unsigned int i = 0; i < clauses.getSize(); i++) {
+        if (clauses.get(i).getSize() > 0) {
+            nbClauses++;
+            CPPUNIT_ASSERT(s.addClause(clauses.get(i)));
+        }
+    }
+    CPPUNIT_ASSERT(nbClauses < r.getNbClauses());
+    const saturnin::Array<saturnin::Lit>& ext = simp.getExtensionStack();
+    for (unsigned int i = 0; i < ext.getSize(); i += ext.get(i) + 1) {
+        s.addEliminatedClause((const saturnin::Lit*) ext + i + 1, ext.get(i));
+    }
+    s.solve(std::numeric_limits<unsigned int>::max());
+    CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+
+    //the model must satisfy the original clauses
+    CPPUNIT_ASSERT(satisfies(s, r.getClauses()));
+}
 
+void SimplifierTest::testEliminationUNSAT() {
+    //the literals proven by the revival falsify some clauses, which mustn't
+    //be taken for the removed ones
+    const int clauses[][5] = {
+        {-6, 2, 0}, {5, 3, -1, 0}, {-6, -2, -4, -5, 3}, {-6, 4, -5, -3, 0},
+        {5, -2, 0}, {6, -1, -3, 0}, {-5, 6, 0}, {-2, -3, -6, 0},
+        {1, 3, 6, 0}, {-6, -5, 4, 0}, {1, 5, -3, 0}, {-2, -4, 5, 0}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > original = toClauses(clauses);
+    saturnin::Simplifier simp(6, original.getSize());
+    for (unsigned int i = 0; i < original.getSize(); i++) {
+        simp.addClause((const saturnin::Lit*) original[i], original[i].getSize());
+    }
+    simp.revival(4);
+    simp.eliminateVariables();
+    CPPUNIT_ASSERT_EQUAL(wFalse, simp.getState());
+}
+
+void SimplifierTest::testEquivalences() {
+    //x0 = x1 = -x2 and two ternary clauses using them
+    const int clauses[][3] = {
+        {1, -2, 0}, {-1, 2, 0}, {2, 3, 0}, {-2, -3, 0},
+        {2, 4, 5}, {-3, -4, 5}, {1, 3, -5}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > original = toClauses(clauses);
+    saturnin::Simplifier simp(5, original.getSize());
+    for (unsigned int i = 0; i < original.getSize(); i++) {
+        simp.addClause((const saturnin::Lit*) original[i], original[i].getSize());
+    }
+    //x2 must keep its clauses, therefore x0 and x1 are replaced by -x2
+    simp.freeze(2);
+    CPPUNIT_ASSERT_EQUAL(2U, simp.substituteEquivalences());
+    CPPUNIT_ASSERT_EQUAL(2U, simp.getNbSubstitutedVars());
+    CPPUNIT_ASSERT_EQUAL(wUnknown, simp.getState());
+    const saturnin::Array<saturnin::Array<saturnin::Lit> >& remaining = simp.getClauses();
+    for (unsigned int i = 0; i < remaining.getSize(); i++) {
+        for (unsigned int j = 0; j < remaining.get(i).getSize(); j++) {
+            CPPUNIT_ASSERT(saturnin::VariablesManager::getVar(remaining.get(i).get(j)) > 1);
+        }
+    }
+
+    saturnin::Solver s(5, original.getSize());
+    for (unsigned int i = 0; i < remaining.getSize(); i++) {
+        if (remaining.get(i).getSize() > 0) {
+            CPPUNIT_ASSERT(s.addClause(remaining.get(i)));
+        }
+    }
+    const saturnin::Array<saturnin::Lit>& ext = simp.getExtensionStack();
+    for (unsigned int i = 0; i < ext.getSize(); i += ext.get(i) + 1) {
+        s.addEliminatedClause((const saturnin::Lit*) ext + i + 1, ext.get(i));
+    }
+    s.solve(std::numeric_limits<unsigned int>::max());
+    CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+    CPPUNIT_ASSERT(satisfies(s, original));
+
+    //x0 and -x0 in the same component
+    saturnin::Simplifier contradiction(2, 4);
+    const int contradictory[][2] = {{1, -2}, {-1, 2}, {1, 2}, {-1, -2}};
+    saturnin::Array<saturnin::Array<saturnin::Lit> > binaries = toClauses(contradictory);
+    for (unsigned int i = 0; i < binaries.getSize(); i++) {
+        contradiction.addClause((const saturnin::Lit*) binaries[i], 2);
+    }
+    CPPUNIT_ASSERT_EQUAL(0U, contradiction.substituteEquivalences());
+    CPPUNIT_ASSERT_EQUAL(wFalse, contradiction.getState());
+}
+
+void SimplifierTest::testBlockedClauses() {
+    //no clause is blocked, but the first one is covered: the resolvent on x1
+    //adds x3 to it, which then makes it blocked on x2
+    const int clauses[][2] = {{1, 2}, {-1, 3}, {-2, -3}};
+    saturnin::Array<saturnin::Array<saturnin::Lit> > original = toClauses(clauses);
+    const unsigned int nbClauses = original.getSize();
+    saturnin::Simplifier blocked(3, nbClauses);
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        blocked.addClause((const saturnin::Lit*) original[i], original[i].getSize());
+    }
+    CPPUNIT_ASSERT_EQUAL(0U, blocked.eliminateBlockedClauses());
+    CPPUNIT_ASSERT_EQUAL(0U, blocked.getNbBlockedClauses());
+
+    saturnin::Simplifier simp(3, nbClauses);
+    for (unsigned int i = 0; i < nbClauses; i++) {
+        simp.addClause((const saturnin::Lit*) original[i], original[i].getSize());
+    }
+    //once the covered clause is removed, the others are blocked
+    CPPUNIT_ASSERT_EQUAL(nbClauses, simp.eliminateBlockedClauses(true));
+    CPPUNIT_ASSERT_EQUAL(nbClauses, simp.getNbBlockedClauses());
+    CPPUNIT_ASSERT_EQUAL(1U, simp.getNbCoveredClauses());
+    const saturnin::Array<saturnin::Array<saturnin::Lit> >& remaining = simp.getClauses();
+    for (unsigned int i = 0; i < remaining.getSize(); i++) {
+        CPPUNIT_ASSERT_EQUAL(0U, remaining.get(i).getSize());
+    }
+
+    //the extension stack must give a model of the original clauses
+    saturnin::Solver s(3, nbClauses);
+    const saturnin::Array<saturnin::Lit>& ext = simp.getExtensionStack();
+    for (unsigned int i = 0; i < ext.getSize(); i += ext.get(i) + 1) {
+        s.addEliminatedClause((const saturnin::Lit*) ext + i + 1, ext.get(i));
+    }
+    s.solve(std::numeric_limits<unsigned int>::max());
+    CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+    CPPUNIT_ASSERT(satisfies(s, original));
+}
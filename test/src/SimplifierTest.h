@@ -28,12 +28,27 @@ public:
     CPPUNIT_TEST_SUITE(SimplifierTest);
     CPPUNIT_TEST(testCreation);
     CPPUNIT_TEST(testRevival);
+    CPPUNIT_TEST(testRevivalProbing);
+    CPPUNIT_TEST(testElimination);
+    CPPUNIT_TEST(testEliminationUNSAT);
+    CPPUNIT_TEST(testEquivalences);
+    CPPUNIT_TEST(testBlockedClauses);
     CPPUNIT_TEST_SUITE_END();
     
     void testCreation();
     
     void testRevival();
     
+    void testRevivalProbing();
+    
+    void testElimination();
+    
+    void testEliminationUNSAT();
+    
+    void testEquivalences();
+    
+    void testBlockedClauses();
+    
 };
 
 #endif	/* SIMPLIFIERTEST_H */
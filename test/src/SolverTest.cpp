@@ -4,6 +4,7 @@
 #include "../../include/saturnin/Solver.h"
 #include "../../include/saturnin/CNFReader.h"
 #include "../../include/saturnin/Logger.h"
+#include "TestClauses.h"
 
 #include <cstdint>
 
@@ -271,6 +272,82 @@ void SolverTest::testPropagation() {
     }
 }
 
+void SolverTest::testBinaryWith() {
+    saturnin::Solver s(4, 4);
+
+    saturnin::Lit a = 0;
+    saturnin::Lit na = 1;
+    saturnin::Lit b = 2;
+    saturnin::Lit c = 4;
+    saturnin::Lit d = 6;
+    saturnin::Lit clause1[] = {a, b};
+    saturnin::Lit clause2[] = {a, c};
+    saturnin::Lit clause3[] = {a, c, d};
+    saturnin::Lit clause4[] = {na, d};
+
+    CPPUNIT_ASSERT(s.addClause(clause1, 2));
+    CPPUNIT_ASSERT(s.addClause(clause2, 2));
+    CPPUNIT_ASSERT(s.addClause(clause3, 3));
+    CPPUNIT_ASSERT(s.addClause(clause4, 2));
+    CPPUNIT_ASSERT_EQUAL(3U, s.getNbBinaryClauses());
+
+    //the clause of size 3 shares the watch list of a, but isn't binary
+    saturnin::Array<saturnin::Lit> binaries;
+    s.getBinaryWith(a, binaries);
+    CPPUNIT_ASSERT_EQUAL(2U, binaries.getSize());
+    CPPUNIT_ASSERT_EQUAL(b, binaries[0U]);
+    CPPUNIT_ASSERT_EQUAL(c, binaries[1U]);
+
+    saturnin::Array<saturnin::Lit> others;
+    s.getBinaryWith(d, others);
+    CPPUNIT_ASSERT_EQUAL(1U, others.getSize());
+    CPPUNIT_ASSERT_EQUAL(na, others[0U]);
+}
+
+void SolverTest::testTernaryPropagation() {
+
+    {
+        //the ternary clause propagates its last unassigned literal, whatever
+        //its position in the watcher
+        saturnin::Solver s(3, 4);
+
+        saturnin::Lit a = 0;
+        saturnin::Lit na = 1;
+        saturnin::Lit b = 2;
+        saturnin::Lit c = 4;
+        saturnin::Lit nc = 5;
+        saturnin::Lit array[] = {a, b, c};
+
+        CPPUNIT_ASSERT(s.addClause(array, 3));
+        CPPUNIT_ASSERT(s.addClause(&nc, 1));
+        CPPUNIT_ASSERT(wUnknown == s.getVarValue(saturnin::VariablesManager::getVar(a)));
+        CPPUNIT_ASSERT(wUnknown == s.getVarValue(saturnin::VariablesManager::getVar(b)));
+        CPPUNIT_ASSERT(s.addClause(&na, 1));
+        CPPUNIT_ASSERT(wTrue == s.getVarValue(saturnin::VariablesManager::getVar(b)));
+        CPPUNIT_ASSERT_EQUAL(1U, s.getInitialClauses().getSize());
+    }
+
+    {
+        //two ternary clauses leading to a conflict
+        saturnin::Solver s(3, 4);
+
+        saturnin::Lit a = 0;
+        saturnin::Lit na = 1;
+        saturnin::Lit b = 2;
+        saturnin::Lit nb = 3;
+        saturnin::Lit c = 4;
+        saturnin::Lit nc = 5;
+        saturnin::Lit clause1[] = {a, b, c};
+        saturnin::Lit clause2[] = {a, b, nc};
+
+        CPPUNIT_ASSERT(s.addClause(clause1, 3));
+        CPPUNIT_ASSERT(s.addClause(clause2, 3));
+        CPPUNIT_ASSERT(s.addClause(&na, 1));
+        CPPUNIT_ASSERT(!s.addClause(&nb, 1));
+        CPPUNIT_ASSERT(wFalse == s.getState());
+    }
+}
+
 void SolverTest::testSearchNoConflict() {
 
     {
@@ -328,6 +405,8 @@ void SolverTest::testSearchConflict() {
     {
         saturnin::Solver s(3, 4);
         s.setVerbosity(0);
+        //the probing would prove c as both b and -b imply it
+        s.setProbing(false);
 
         saturnin::Lit clause2[] = {c, nb};
         saturnin::Lit clause[] = {c, b};
@@ -710,7 +789,7 @@ void SolverTest::testPrintClauses() {
     delete(help);
 
 
-    const char* expected = "\x1B[0;32m1\x1B[0;30m \x1B[0;30m3\x1B[0;30m \x1B[0;31m2\x1B[0;30m, \x1B[0;32m1\x1B[0;30m \x1B[0;30m-3\x1B[0;30m \x1B[0;31m2\x1B[0;30m | 1 3 2, 1 -3 2";
+    const char* expected = "\x1B[0;32m1\x1B[0;30m \x1B[0;31m2\x1B[0;30m \x1B[0;30m3\x1B[0;30m, \x1B[0;32m1\x1B[0;30m \x1B[0;31m2\x1B[0;30m \x1B[0;30m-3\x1B[0;30m | 1 2 3, 1 2 -3";
 
     const long bufSize = 1024;
     char buf[bufSize + 1];
@@ -729,7 +808,8 @@ void SolverTest::testPrintClauses() {
 
 }
 
-void SolverTest::testSolveInstance(const char* fileName, saturnin::wbool result, const char* answer) const {
+void SolverTest::testSolveInstance(const char* fileName, saturnin::wbool result, const char* answer, unsigned int chronoThreshold,
+        saturnin::Solver::BranchingHeuristic branching, bool targetPhase, bool vivify) const {
     saturnin::CNFReader* reader = new saturnin::CNFReader(fileName);
 
     saturnin::CNFReader::CNFReaderErrors error = reader->read();
@@ -753,6 +833,12 @@ void SolverTest::testSolveInstance(const char* fileName, saturnin::wbool result,
     reader = NULL;
 
     s.setVerbosity(answer != NULL ? 1001 : 0);
+    s.setChronologicalBacktrack(chronoThreshold);
+    s.setBranchingHeuristic(branching);
+    CPPUNIT_ASSERT(s.getBranchingHeuristic() == branching);
+    s.setTargetPhase(targetPhase);
+    s.setRephase(targetPhase);
+    s.setVivification(vivify);
 
     if (answer != NULL) {
         const char* sol = answer;
@@ -786,6 +872,282 @@ void SolverTest::testCompleteSAT() {
     testSolveInstance(fileName, wTrue);
 }
 
+void SolverTest::testChronologicalBacktrack() {
+    testSolveInstance("instances/dp04s04.shuffled.cnf", wTrue, NULL, 1);
+    testSolveInstance("instances/dp04u03.shuffled.cnf", wFalse, NULL, 1);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 1);
+}
+
+void SolverTest::testVMTF() {
+    testSolveInstance("instances/dp04s04.shuffled.cnf", wTrue, NULL, 0, saturnin::Solver::BranchingHeuristic::VMTF);
+    testSolveInstance("instances/dp04u03.shuffled.cnf", wFalse, NULL, 0, saturnin::Solver::BranchingHeuristic::VMTF);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 0, saturnin::Solver::BranchingHeuristic::VMTF);
+    testSolveInstance("instances/dp04u03.shuffled.cnf", wFalse, NULL, 1, saturnin::Solver::BranchingHeuristic::VMTF);
+}
+
+void SolverTest::testLRB() {
+    testSolveInstance("instances/dp04s04.shuffled.cnf", wTrue, NULL, 0, saturnin::Solver::BranchingHeuristic::LRB);
+    testSolveInstance("instances/dp04u03.shuffled.cnf", wFalse, NULL, 0, saturnin::Solver::BranchingHeuristic::LRB);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 0, saturnin::Solver::BranchingHeuristic::LRB);
+    testSolveInstance("instances/dp04u03.shuffled.cnf", wFalse, NULL, 1, saturnin::Solver::BranchingHeuristic::LRB);
+}
+
+void SolverTest::testTargetPhase() {
+    using saturnin::Solver;
+    testSolveInstance("instances/dp04s04.shuffled.cnf", wTrue, NULL, 0, Solver::BranchingHeuristic::VSIDS, true);
+    testSolveInstance("instances/dp04u03.shuffled.cnf", wFalse, NULL, 0, Solver::BranchingHeuristic::VSIDS, true);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 0, Solver::BranchingHeuristic::VSIDS, true);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 1, Solver::BranchingHeuristic::VMTF, true);
+}
+
+void SolverTest::testVivification() {
+    using saturnin::Solver;
+    testSolveInstance("instances/dp04s04.shuffled.cnf", wTrue, NULL, 0, Solver::BranchingHeuristic::VSIDS, false, false);
+    testSolveInstance("instances/dp04u03.shuffled.cnf", wFalse, NULL, 0, Solver::BranchingHeuristic::VSIDS, false, false);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 0, Solver::BranchingHeuristic::VSIDS, false, false);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 1, Solver::BranchingHeuristic::LRB, true, true);
+    testSolveInstance("instances/dp10s10.shuffled.cnf", wTrue, NULL, 1, Solver::BranchingHeuristic::VMTF, false, true);
+}
+
+void SolverTest::testSubsumption() {
+    const int clauses[][7] = {
+        //x0 x1 x2 subsumes x0 x1 x2 x3 and strengthens -x0 x1 x2 x4
+        {1, 2, 3, 0}, {1, 2, 3, 4, 0}, {-1, 2, 3, 5, 0},
+        //x5 x6 subsumes x5 x6 x7 and strengthens -x5 x6 x8
+        {6, 7, 0}, {6, 7, 8, 0}, {-6, 7, 9, 0},
+        //no literal is pure, otherwise the clauses would be satisfied first
+        {-2, -3, -4, -5, -7, -8, -9}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > batch = toClauses(clauses);
+    for (unsigned int k = 0; k < 2; k++) {
+        bool subsume = k == 0;
+        saturnin::Solver s(10, batch.getSize());
+        s.setVerbosity(0);
+        s.setSubsumption(subsume);
+        for (unsigned int i = 0; i < batch.getSize(); i++) {
+            CPPUNIT_ASSERT(s.addClause(batch[i]));
+        }
+        CPPUNIT_ASSERT_EQUAL(7U, s.getNbClauses());
+        s.solve(std::numeric_limits<unsigned int>::max());
+        CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+        CPPUNIT_ASSERT(s.validate());
+        CPPUNIT_ASSERT_EQUAL(!subsume, hasClause(s, {1, 2, 3, 4}));
+        CPPUNIT_ASSERT_EQUAL(!subsume, hasClause(s, {-1, 2, 3, 5}));
+        CPPUNIT_ASSERT_EQUAL(subsume, hasClause(s, {2, 3, 5}));
+        CPPUNIT_ASSERT_EQUAL(!subsume, hasClause(s, {6, 7, 8}));
+        CPPUNIT_ASSERT_EQUAL(!subsume, hasClause(s, {-6, 7, 9}));
+    }
+}
+
+void SolverTest::testProbing() {
+    //a literal given as n > 0 is x(n-1) and -n is its negation
+    const int clauses[][3] = {
+        //x0 implies x1 and x2, which lead to a conflict: x0 fails
+        {-1, 2, 0}, {-1, 3, 0}, {-2, -3, 4}, {-2, -3, -4}, {1, 5, 6}, {-5, -6, 4},
+        //both x6 and -x6 imply x7
+        {-7, 8, 0}, {7, 8, 0}, {-8, 5, 6},
+        //x8 implies -x11 and -x8 implies x11, through clauses that have no
+        //hyper-binary resolvent
+        {-9, 10, 0}, {-9, 11, 0}, {-10, -11, -12},
+        {9, 13, 0}, {9, 14, 0}, {-13, -14, 12}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > batch = toClauses(clauses);
+    for (unsigned int k = 0; k < 2; k++) {
+        bool probe = k == 0;
+        saturnin::Solver s(14, batch.getSize());
+        s.setVerbosity(0);
+        s.setProbing(probe);
+        //the subsumption would find the equivalence as binary clauses
+        s.setSubsumption(false);
+        for (unsigned int i = 0; i < batch.getSize(); i++) {
+            CPPUNIT_ASSERT(s.addClause(batch[i]));
+        }
+        s.solve(std::numeric_limits<unsigned int>::max());
+        CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+        CPPUNIT_ASSERT(s.validate());
+        CPPUNIT_ASSERT_EQUAL(probe ? 1UL : 0UL, (unsigned long) s.getNbFailedLiterals());
+        CPPUNIT_ASSERT_EQUAL(probe ? 1UL : 0UL, (unsigned long) s.getNbProbedUnits());
+        //the equivalence of x8 and -x11 is added as two binary clauses
+        CPPUNIT_ASSERT_EQUAL(probe, hasClause(s, {9, 12}));
+        CPPUNIT_ASSERT_EQUAL(probe, hasClause(s, {-9, -12}));
+    }
+}
+
+void SolverTest::testTransitiveReduction() {
+    const int clauses[][3] = {
+        //x0 -> x1 -> x2 makes x0 -> x2 transitive
+        {-1, 2, 0}, {-2, 3, 0}, {-1, 3, 0},
+        //x0 and x1 imply x3 which gives the hyper-binary resolvent -x0 x3
+        {-1, -2, 4}, {-4, 5, -1},
+        //no literal is pure
+        {1, -3, 5}, {1, -5, -2}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > batch = toClauses(clauses);
+    for (unsigned int k = 0; k < 2; k++) {
+        bool transitive = k == 0;
+        saturnin::Solver s(5, batch.getSize());
+        s.setVerbosity(0);
+        s.setSubsumption(false);
+        s.setTransitiveReduction(transitive);
+        for (unsigned int i = 0; i < batch.getSize(); i++) {
+            CPPUNIT_ASSERT(s.addClause(batch[i]));
+        }
+        CPPUNIT_ASSERT_EQUAL(3U, s.getNbBinaryClauses());
+        s.solve(std::numeric_limits<unsigned int>::max());
+        CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+        CPPUNIT_ASSERT(s.validate());
+        CPPUNIT_ASSERT(hasClause(s, {-1, 4}));
+        CPPUNIT_ASSERT_EQUAL(!transitive, hasClause(s, {-1, 3}));
+        CPPUNIT_ASSERT(hasClause(s, {-1, 2}));
+        CPPUNIT_ASSERT(hasClause(s, {-2, 3}));
+        CPPUNIT_ASSERT_EQUAL(3U + (unsigned int) s.getNbHyperBinaries() - (unsigned int) s.getNbTransitiveBinaries(),
+                s.getNbBinaryClauses());
+    }
+}
+
+void SolverTest::testAddClauses() {
+    using saturnin::Lit;
+    using saturnin::VariablesManager;
+    const int clauses[][4] = {
+        {1, 2, 3, 0}, {3, 2, 1, 0},
+        //a tautology and a binary clause given twice
+        {1, -1, 4, 0}, {2, 2, -4, 0}, {-4, 2, 0, 0},
+        //x4 makes the next clause binary and satisfies the one after
+        {5, 0, 0, 0}, {-5, 1, 3, 0}, {4, 5, -3, 0},
+        {-1, -2, -3, 4}
+    };
+    saturnin::Array<saturnin::Array<Lit> > batch = toClauses(clauses);
+    saturnin::Solver s(5, batch.getSize());
+    s.setVerbosity(0);
+    CPPUNIT_ASSERT(s.addClauses(batch));
+    CPPUNIT_ASSERT_EQUAL(2U, s.getNbBinaryClauses());
+    CPPUNIT_ASSERT_EQUAL(4U, s.getNbClauses());
+    s.solve(std::numeric_limits<unsigned int>::max());
+    CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+    CPPUNIT_ASSERT(s.validate());
+    CPPUNIT_ASSERT(satisfies(s, batch));
+
+    //long clauses are sorted by a radix sort: the same clause given in
+    //reverse order is a duplicate, and a tautology is found whatever the
+    //distance between its two literals
+    saturnin::Array<saturnin::Array<Lit> > longClauses(3);
+    for (unsigned int i = 0; i < 3; i++) {
+        longClauses.push(saturnin::Array<Lit>(40U));
+    }
+    for (unsigned int v = 0; v < 600; v += 20) {
+        longClauses[0U].push(VariablesManager::getLit(v, v % 3 == 0));
+        longClauses[1U].push(VariablesManager::getLit(580 - v, (580 - v) % 3 == 0));
+        longClauses[2U].push(VariablesManager::getLit(v + 1, true));
+    }
+    longClauses[2U].push(VariablesManager::getLit(1, false));
+    saturnin::Solver l(600, 3);
+    l.setVerbosity(0);
+    CPPUNIT_ASSERT(l.addClauses(longClauses));
+    CPPUNIT_ASSERT_EQUAL(1U, l.getNbClauses());
+
+    //x0 and -x0 given in the same batch
+    saturnin::Array<saturnin::Array<Lit> > contradiction(2);
+    contradiction.push(saturnin::Array<Lit>(1U));
+    contradiction[0U].push(VariablesManager::getLit(0, true));
+    contradiction.push(saturnin::Array<Lit>(1U));
+    contradiction[1U].push(VariablesManager::getLit(0, false));
+    saturnin::Solver u(1, 2);
+    u.setVerbosity(0);
+    CPPUNIT_ASSERT(!u.addClauses(contradiction));
+    CPPUNIT_ASSERT_EQUAL(wFalse, u.getState());
+}
+
+void SolverTest::testBinaryMinimization() {
+    //This test may fail if the heuristic for choosing variables is changed:
+    //the decisions -x0, -x4 and -x3 make x3 x0 x4 the learnt clause, that
+    //is minimized into x3 x0 with x3 -x4
+    const int clauses[][4] = {
+        {-1, -2, 3, 0}, {1, 2, 4, 5}, {1, -2, 4, 5}, {4, -5, 0}, {-3, -4, 2, 0}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > batch = toClauses(clauses);
+    for (unsigned int k = 0; k < 2; k++) {
+        bool minimize = k == 0;
+        saturnin::Solver s(5, batch.getSize());
+        s.setVerbosity(0);
+        s.setProbing(false);
+        s.setSubsumption(false);
+        s.setOnTheFlySubsumption(false);
+        s.setBinaryMinimization(minimize);
+        for (unsigned int i = 0; i < batch.getSize(); i++) {
+            CPPUNIT_ASSERT(s.addClause(batch[i]));
+        }
+        s.solve(std::numeric_limits<unsigned int>::max());
+        CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+        CPPUNIT_ASSERT(s.validate());
+        CPPUNIT_ASSERT_EQUAL((uint64_t) 1, s.getNbConflict());
+        CPPUNIT_ASSERT_EQUAL(minimize, hasClause(s, {1, 4}));
+    }
+
+    saturnin::CNFReader r("instances/dp10s10.shuffled.cnf");
+    CPPUNIT_ASSERT(r.read() == saturnin::CNFReader::CNFReaderErrors::cnfError_noError);
+    for (unsigned int k = 0; k < 2; k++) {
+        saturnin::Solver s(r.getNbVar(), r.getNbClauses());
+        s.setVerbosity(0);
+        s.setBinaryMinimization(k == 0);
+        CPPUNIT_ASSERT(s.addClauses(r.getClauses()));
+        s.solve(std::numeric_limits<unsigned int>::max());
+        CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+        CPPUNIT_ASSERT(s.validate());
+    }
+}
+
+void SolverTest::testOnTheFlySubsumption() {
+    //This test may fail if the heuristic for choosing variables is changed:
+    //the decisions -x0, -x4, -x3 and -x2 lead to a conflict where the
+    //resolvent on x1 subsumes the reason, which becomes the learnt clause
+    const int clauses[][5] = {
+        {1, 2, 3, 4, 5}, {1, -2, 3, 4, 5}, {-1, -3, -4, -5, 2}
+    };
+    saturnin::Array<saturnin::Array<saturnin::Lit> > batch = toClauses(clauses);
+    for (unsigned int k = 0; k < 2; k++) {
+#ifdef SATURNIN_DB
+        //the strengthening is disabled to keep the proof database consistent
+        bool otfs = false;
+#else
+        bool otfs = k == 0;
+#endif /* SATURNIN_DB */
+        saturnin::Solver s(5, batch.getSize());
+        s.setVerbosity(0);
+        s.setProbing(false);
+        s.setSubsumption(false);
+        s.setOnTheFlySubsumption(k == 0);
+        for (unsigned int i = 0; i < batch.getSize(); i++) {
+            CPPUNIT_ASSERT(s.addClause(batch[i]));
+        }
+        s.solve(std::numeric_limits<unsigned int>::max());
+        CPPUNIT_ASSERT_EQUAL(wTrue, s.getState());
+        CPPUNIT_ASSERT(s.validate());
+        CPPUNIT_ASSERT_EQUAL((uint64_t) 1, s.getNbConflict());
+        CPPUNIT_ASSERT_EQUAL(otfs, hasClause(s, {1, 3, 4, 5}));
+        CPPUNIT_ASSERT_EQUAL(!otfs, hasClause(s, {1, 2, 3, 4, 5}));
+        CPPUNIT_ASSERT_EQUAL(otfs ? 0U : 1U, s.getNbLearntClauses());
+    }
+
+    const char* fileNames[] = {"instances/dp10s10.shuffled.cnf", "instances/dp04u03.shuffled.cnf"};
+    saturnin::wbool results[] = {wTrue, wFalse};
+    for (unsigned int i = 0; i < 2; i++) {
+        saturnin::CNFReader r(fileNames[i]);
+        CPPUNIT_ASSERT(r.read() == saturnin::CNFReader::CNFReaderErrors::cnfError_noError);
+        for (unsigned int k = 0; k < 2; k++) {
+            saturnin::Solver s(r.getNbVar(), r.getNbClauses());
+            s.setVerbosity(0);
+            s.setOnTheFlySubsumption(k == 0);
+            CPPUNIT_ASSERT(s.addClauses(r.getClauses()));
+            s.solve(std::numeric_limits<unsigned int>::max());
+            CPPUNIT_ASSERT_EQUAL(results[i], s.getState());
+            if (results[i] == wTrue) {
+                CPPUNIT_ASSERT(s.validate());
+            }
+            CPPUNIT_ASSERT(s.getNbOnTheFlyLearnt() <= s.getNbOnTheFlyStrengthened());
+        }
+    }
+}
+
 void SolverTest::testCompleteUNSAT() {
     const char* fileName = "instances/dp04u03.shuffled.cnf";
     testSolveInstance(fileName, wFalse);
@@ -31,6 +31,8 @@ public:
     CPPUNIT_TEST(testAddClause);
     CPPUNIT_TEST(testClauseSizeAddition);
     CPPUNIT_TEST(testPropagation);
+    CPPUNIT_TEST(testBinaryWith);
+    CPPUNIT_TEST(testTernaryPropagation);
     CPPUNIT_TEST(testPrintClauses);
     CPPUNIT_TEST(testSimplification);
     CPPUNIT_TEST(testSearchNoConflict);
@@ -42,6 +44,17 @@ public:
     CPPUNIT_TEST(testCompleteUNSAT);
     CPPUNIT_TEST(testCompleteSAT);
     CPPUNIT_TEST(testdp10);
+    CPPUNIT_TEST(testChronologicalBacktrack);
+    CPPUNIT_TEST(testVMTF);
+    CPPUNIT_TEST(testLRB);
+    CPPUNIT_TEST(testTargetPhase);
+    CPPUNIT_TEST(testVivification);
+    CPPUNIT_TEST(testSubsumption);
+    CPPUNIT_TEST(testProbing);
+    CPPUNIT_TEST(testTransitiveReduction);
+    CPPUNIT_TEST(testAddClauses);
+    CPPUNIT_TEST(testBinaryMinimization);
+    CPPUNIT_TEST(testOnTheFlySubsumption);
     CPPUNIT_TEST(testPhasedElimination);
     CPPUNIT_TEST(testBigInstance);
     CPPUNIT_TEST(testPresumedInstance);
@@ -98,6 +111,18 @@ public:
      */
     void testPropagation();
 
+    /**
+     * Check the retrieval of the binary clauses from the watch lists
+     */
+    void testBinaryWith();
+
+    /**
+     * Check that the initial ternary clauses, watched by each of their
+     * literals, propagate their last unassigned literal whatever its
+     * position and report a conflict when all their literals are false
+     */
+    void testTernaryPropagation();
+
     /**
      * Check the print of clauses
      */
@@ -150,9 +175,75 @@ public:
      */
     void testClauseSizeAddition();
 
+    /**
+     * Solve real instances while backtracking chronologically as often as
+     * possible
+     */
+    void testChronologicalBacktrack();
+
+    /**
+     * Solve real instances while picking the decisions with VMTF
+     */
+    void testVMTF();
+
+    /**
+     * Solve real instances while picking the decisions with LRB
+     */
+    void testLRB();
+
+    /**
+     * Solve real instances while deciding with the target phases and
+     * rephasing frequently
+     */
+    void testTargetPhase();
+
+    /**
+     * Solve real instances without the vivification of the learnt clauses,
+     * and with it along with the other options
+     */
+    void testVivification();
+
+    /**
+     * Check that the subsumed clauses are removed and that the clauses are
+     * strengthened by the self-subsuming resolution
+     */
+    void testSubsumption();
+
+    /**
+     * Check that the probing finds the failed literals, the literals
+     * implied by both polarities of a variable and the equivalences
+     */
+    void testProbing();
+
+    /**
+     * Check that the probing adds the hyper-binary resolvents and that the
+     * transitive binary clauses are removed
+     */
+    void testTransitiveReduction();
+
+    /**
+     * Check that the clauses added at once are sorted and that the
+     * tautologies, the duplicates and the satisfied clauses are dropped
+     */
+    void testAddClauses();
+
+    /**
+     * Check that the learnt clauses are minimized with the binary clauses
+     * only when it is enabled, and that the solution is still valid
+     */
+    void testBinaryMinimization();
+
+    /**
+     * Check that the reasons subsumed during the analysis are strengthened
+     * only when it is enabled, and that the answers are still right
+     */
+    void testOnTheFlySubsumption();
+
 private:
     
-    void testSolveInstance(const char* fileName, saturnin::wbool result, const char* answer = NULL) const;
+    void testSolveInstance(const char* fileName, saturnin::wbool result, const char* answer = NULL, unsigned int chronoThreshold = 0,
+            saturnin::Solver::BranchingHeuristic branching = saturnin::Solver::BranchingHeuristic::VSIDS,
+            bool targetPhase = false, bool vivify = true) const;
     
     void createPigeonHoleProblem(unsigned int n, saturnin::Solver& s, bool print = false);
     
@@ -0,0 +1,115 @@
+/*
+Copyright (c) <2015> <B.Hoessen>
+
+This file is part of saturnin.
+
+saturnin is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+saturnin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with saturnin.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TESTCLAUSES_H
+#define	TESTCLAUSES_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include "../../include/saturnin/Array.h"
+#include "../../include/saturnin/Solver.h"
+#include "../../include/saturnin/VariablesManager.h"
+
+/**
+ * Convert a literal given as in the DIMACS format: n > 0 is the variable
+ * n - 1 and -n is its negation
+ * @param l the literal to convert, different from 0
+ * @return the corresponding literal
+ */
+inline saturnin::Lit toLit(int l) {
+    return saturnin::VariablesManager::getLit(std::abs(l) - 1, l > 0);
+}
+
+/**
+ * Convert clauses given as in the DIMACS format. A clause ends at its first
+ * 0 or after N literals
+ * @param clauses the clauses to convert
+ * @return the converted clauses
+ */
+template<size_t M, size_t N>
+saturnin::Array<saturnin::Array<saturnin::Lit> > toClauses(const int (&clauses)[M][N]) {
+    saturnin::Array<saturnin::Array<saturnin::Lit> > converted(M);
+    for (unsigned int i = 0; i < M; i++) {
+        converted.push(saturnin::Array<saturnin::Lit>(N));
+        for (unsigned int j = 0; j < N && clauses[i][j] != 0; j++) {
+            converted[i].push(toLit(clauses[i][j]));
+        }
+    }
+    return converted;
+}
+
+/**
+ * Check whether a solver holds a given initial clause, with no regard to the
+ * order of its literals. The solver renames the variables in the order they
+ * are first given, therefore they must be given in increasing order
+ * @param s the solver to look into
+ * @param clause the literals of the clause, as in the DIMACS format
+ * @return true if @a clause is a binary clause or an initial clause of @a s
+ */
+inline bool hasClause(const saturnin::Solver& s, std::initializer_list<int> clause) {
+    if (clause.size() == 2) {
+        saturnin::Array<saturnin::Lit> binaries;
+        s.getBinaryWith(toLit(*clause.begin()), binaries);
+        for (unsigned int i = 0; i < binaries.getSize(); i++) {
+            if (binaries.get(i) == toLit(*(clause.begin() + 1))) {
+                return true;
+            }
+        }
+        return false;
+    }
+    const saturnin::Array<saturnin::CRef>& clauses = s.getInitialClauses();
+    for (unsigned int i = 0; i < clauses.getSize(); i++) {
+        const saturnin::Clause& c = s.getClause(clauses.get(i));
+        bool same = c.getSize() == clause.size();
+        for (const int* l = clause.begin(); same && l != clause.end(); l++) {
+            same = false;
+            for (unsigned int j = 0; !same && j < c.getSize(); j++) {
+                same = c.getLit(j) == toLit(*l);
+            }
+        }
+        if (same) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check that the model found by a solver satisfies some clauses
+ * @param s a solver that found a model
+ * @param clauses the clauses to check
+ * @return true if each clause has a literal true in the model of @a s
+ */
+inline bool satisfies(const saturnin::Solver& s, const saturnin::Array<saturnin::Array<saturnin::Lit> >& clauses) {
+    for (unsigned int i = 0; i < clauses.getSize(); i++) {
+        bool satisfied = false;
+        for (unsigned int j = 0; !satisfied && j < clauses.get(i).getSize(); j++) {
+            saturnin::Lit l = clauses.get(i).get(j);
+            satisfied = s.getVarValue(saturnin::VariablesManager::getVar(l)) ==
+                    (saturnin::VariablesManager::getLitSign(l) ? wTrue : wFalse);
+        }
+        if (!satisfied) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif	/* TESTCLAUSES_H */